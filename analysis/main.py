@@ -1,17 +1,29 @@
-# This is a sample Python script.
+# Summarize a sweep with the compiled fairness-summarize tool and load the
+# tables for the notebooks, instead of globbing the per-run CSVs with pandas.
+#
+#   python3 main.py <sweep dir> [--binary build/scratch/fairness/ns3.39-fairness-summarize-default]
 
-# Press Shift+F10 to execute it or replace it with your code.
-# Press Double Shift to search everywhere for classes, files, tool windows, actions, and settings.
+import argparse
+import os
+import subprocess
 
+import pandas as pd
 
-def print_hi(name):
-    # Use a breakpoint in the code line below to debug your script.
-    print(f'Hi, {name}')  # Press Ctrl+F8 to toggle the breakpoint.
+DEFAULT_BINARY = "build/scratch/fairness/ns3.39-fairness-summarize-default"
 
 
-# Press the green button in the gutter to run the script.
-if __name__ == '__main__':
-    print_hi('DataSpell')
+def summarize(sweep_dir, binary=DEFAULT_BINARY, percentiles="50,90,99"):
+    subprocess.run([binary, "--input=" + sweep_dir, "--percentiles=" + percentiles], check=True)
+    runs = pd.read_csv(os.path.join(sweep_dir, "summary-runs.csv"))
+    groups = pd.read_csv(os.path.join(sweep_dir, "summary-groups.csv"))
+    return runs, groups
+
 
-# See DataSpell help at https://www.jetbrains.com/help/dataspell/
-  
\ No newline at end of file
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument("sweep_dir")
+    parser.add_argument("--binary", default=DEFAULT_BINARY)
+    parser.add_argument("--percentiles", default="50,90,99")
+    args = parser.parse_args()
+    _, groups = summarize(args.sweep_dir, args.binary, args.percentiles)
+    print(groups.to_string(index=False))
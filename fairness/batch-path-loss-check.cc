@@ -0,0 +1,139 @@
+// Check of the BatchPathLoss kernels against the propagation loss models.
+//
+// For Friis, log-distance and three log-distance losses, with their defaults
+// and other parameters, and for a chain of them, compares the RX powers of
+// BatchPathLoss with PropagationLossModel::CalcRxPower() at --points
+// distances, from 0 to beyond the last three log-distance field. The kernels
+// are meant to give the same bits, so any difference is an error, e.g.
+//
+//   ./ns3 run "batch-path-loss-check --points=2000"
+//
+// Exits with 1 if any RX power differs.
+
+#include "lib/batch-path-loss.h"
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/propagation-module.h"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("BatchPathLossCheck");
+
+/**
+ * Compare the batch and model RX powers of a loss chain.
+ *
+ * \param name The name of the chain in the report.
+ * \param loss The first loss model of the chain.
+ * \param txPowerDbm The TX power.
+ * \param distances The distances to check.
+ * \return The number of distances where the RX powers differ.
+ */
+uint32_t
+Check(const std::string& name,
+      Ptr<PropagationLossModel> loss,
+      double txPowerDbm,
+      const std::vector<double>& distances)
+{
+    // Receivers off the axes, so the distances go through CalcDistances too
+    const Vector sender(12.5, -3.25, 1.5);
+    const std::size_t n = distances.size();
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+    std::vector<double> z(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        x[i] = sender.x + 0.6 * distances[i];
+        y[i] = sender.y + 0.8 * distances[i];
+        z[i] = sender.z;
+    }
+    std::vector<double> batchDistances(n);
+    std::vector<double> rxPowers(n);
+    BatchPathLoss::CalcDistances(sender, x.data(), y.data(), z.data(), n, batchDistances.data());
+    BatchPathLoss(loss).CalcRxPower(txPowerDbm, batchDistances.data(), n, rxPowers.data());
+
+    Ptr<ConstantPositionMobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    Ptr<ConstantPositionMobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(sender);
+    uint32_t differences = 0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        b->SetPosition(Vector(x[i], y[i], z[i]));
+        const double expected = loss->CalcRxPower(txPowerDbm, a, b);
+        if (rxPowers[i] != expected)
+        {
+            if (differences == 0)
+            {
+                std::cerr << std::setprecision(17) << name << ": at " << batchDistances[i]
+                          << " m, batch " << rxPowers[i] << " dBm, model " << expected
+                          << " dBm\n";
+            }
+            differences++;
+        }
+    }
+    std::cout << name << ": " << n << " distances, " << differences << " differences\n";
+    return differences;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t points = 2000;
+    double txPower = 16.0206;
+
+    CommandLine cmd;
+    cmd.AddValue("points", "Number of distances to check", points);
+    cmd.AddValue("txPower", "TX power (dBm)", txPower);
+    cmd.Parse(argc, argv);
+    NS_ABORT_MSG_IF(points < 2, "--points must be at least 2");
+
+    // Zero, then log spaced from 1 cm to 10 km, across every reference
+    // distance and three log-distance field boundary
+    std::vector<double> distances = {0};
+    for (uint32_t i = 0; i + 1 < points; i++)
+    {
+        distances.push_back(0.01 * std::pow(1e6, i / (points - 2.0)));
+    }
+
+    Ptr<FriisPropagationLossModel> friis = CreateObject<FriisPropagationLossModel>();
+    Ptr<FriisPropagationLossModel> friis24 = CreateObject<FriisPropagationLossModel>();
+    friis24->SetFrequency(2.412e9);
+    friis24->SetSystemLoss(1.5);
+    friis24->SetMinLoss(10);
+    Ptr<LogDistancePropagationLossModel> logDistance =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<LogDistancePropagationLossModel> logDistance35 =
+        CreateObject<LogDistancePropagationLossModel>();
+    logDistance35->SetPathLossExponent(3.5);
+    logDistance35->SetReference(2, 40.05);
+    Ptr<ThreeLogDistancePropagationLossModel> threeLog =
+        CreateObject<ThreeLogDistancePropagationLossModel>();
+    Ptr<ThreeLogDistancePropagationLossModel> threeLogNear =
+        CreateObjectWithAttributes<ThreeLogDistancePropagationLossModel>("Distance0",
+                                                                         DoubleValue(0.5),
+                                                                         "Distance1",
+                                                                         DoubleValue(20),
+                                                                         "Distance2",
+                                                                         DoubleValue(80),
+                                                                         "Exponent1",
+                                                                         DoubleValue(2.7));
+    Ptr<LogDistancePropagationLossModel> chainHead =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<FriisPropagationLossModel> chainTail = CreateObject<FriisPropagationLossModel>();
+    chainHead->SetNext(chainTail);
+
+    uint32_t differences = 0;
+    differences += Check("Friis", friis, txPower, distances);
+    differences += Check("Friis 2.4 GHz", friis24, txPower, distances);
+    differences += Check("LogDistance", logDistance, txPower, distances);
+    differences += Check("LogDistance 3.5", logDistance35, txPower, distances);
+    differences += Check("ThreeLogDistance", threeLog, txPower, distances);
+    differences += Check("ThreeLogDistance near", threeLogNear, txPower, distances);
+    differences += Check("LogDistance + Friis", chainHead, txPower, distances);
+    return differences > 0 ? 1 : 0;
+}
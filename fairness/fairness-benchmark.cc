@@ -0,0 +1,172 @@
+// Station-count scaling benchmark of the WiFi fairness topology.
+//
+// Runs the fairness scenario for a list of STA counts, each in a fresh child
+// process, for the same simulated time, and reports per size the wall time,
+// the number of simulator events, events per wall second, the peak resident
+// set size and simulated seconds per wall second, e.g.
+//
+//   ./ns3 run "fairness-benchmark --stations=1,2,4,8,16,32,64,128,256,512 --simTime=10"
+//   ./ns3 run "fairness-benchmark --config=scratch/fairness/scenarios/tcp-quic.ini"
+//
+// The table is printed and written to benchmark.csv in --outputDir. Runs are
+// sequential so that they do not compete for cores or memory bandwidth.
+
+#include "lib/scenario-config.h"
+#include "lib/sweep-runner.h"
+#include "lib/wifi-fairness-scenario.h"
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("FairnessBenchmark");
+
+/**
+ * Measurements of one run, passed from the child through a pipe.
+ */
+struct BenchmarkSample
+{
+    double buildSeconds; //!< Wall time of the topology setup.
+    double runSeconds;   //!< Wall time of Simulator::Run.
+    uint64_t events;     //!< Events executed by the simulator.
+};
+
+/**
+ * Build and run one scenario and measure it. Runs in the child process.
+ *
+ * \param config The scenario parameters.
+ * \return The measurements.
+ */
+static BenchmarkSample
+Measure(const ScenarioConfig& config)
+{
+    using Clock = std::chrono::steady_clock;
+    BenchmarkSample sample{};
+
+    Clock::time_point start = Clock::now();
+    WifiFairnessScenario scenario(config);
+    scenario.Build();
+    Clock::time_point built = Clock::now();
+    sample.buildSeconds = std::chrono::duration<double>(built - start).count();
+
+    // The event count is gone once the simulator is destroyed, so read it
+    // from the first destroy event, which also ends the timed span
+    Simulator::ScheduleDestroy([&sample, built]() {
+        sample.runSeconds = std::chrono::duration<double>(Clock::now() - built).count();
+        sample.events = Simulator::GetEventCount();
+    });
+    scenario.Run();
+    return sample;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string config;
+    std::string stations = "1,2,4,8,16,32,64,128,256,512";
+    std::string protocols = "tcp,quic,udp";
+    int simTime = 10;
+    std::string outputDir = "benchmark";
+
+    CommandLine cmd;
+    cmd.AddValue("config", "INI scenario file providing the other parameters", config);
+    cmd.AddValue("stations", "Comma separated STA counts", stations);
+    cmd.AddValue("protocols", "Comma separated protocols the STAs are dealt to in turn", protocols);
+    cmd.AddValue("simTime", "Simulated time of every run (s)", simTime);
+    cmd.AddValue("outputDir", "Directory of the table and the per-run results", outputDir);
+    cmd.Parse(argc, argv);
+
+    const std::vector<std::string> protocolList = SplitList(protocols);
+    NS_ABORT_MSG_IF(protocolList.empty(), "--protocols is empty");
+    std::filesystem::create_directories(outputDir);
+
+    std::ofstream table(outputDir + "/benchmark.csv");
+    const std::string header = "stations,sim_s,build_wall_s,run_wall_s,events,events_per_s,"
+                               "peak_rss_kb,sim_s_per_wall_s";
+    table << header << std::endl;
+    std::cout << header << std::endl;
+
+    for (const auto& count : SplitList(stations))
+    {
+        const int n = std::stoi(count);
+        ScenarioConfig scenarioConfig;
+        if (!config.empty())
+        {
+            std::string configArg = "--config=" + config;
+            char* configArgv[] = {argv[0], configArg.data()};
+            scenarioConfig.Parse(2, configArgv);
+        }
+        scenarioConfig.mix = "";
+        scenarioConfig.nTcp = scenarioConfig.nQuic = scenarioConfig.nUdp = 0;
+        for (int i = 0; i < n; i++)
+        {
+            const std::string& protocol = protocolList[i % protocolList.size()];
+            if (protocol == "tcp")
+            {
+                scenarioConfig.nTcp++;
+            }
+            else if (protocol == "quic")
+            {
+                scenarioConfig.nQuic++;
+            }
+            else if (protocol == "udp")
+            {
+                scenarioConfig.nUdp++;
+            }
+            else
+            {
+                NS_FATAL_ERROR("Unknown protocol " << protocol);
+            }
+        }
+        scenarioConfig.stepsTime = std::max(scenarioConfig.stepsTime, 1);
+        scenarioConfig.steps = std::max(simTime / scenarioConfig.stepsTime - 1, 0);
+        scenarioConfig.outputDir = outputDir + "/stations-" + count;
+
+        // A child per size, so that every run starts from an empty simulator
+        // and its peak RSS is its own
+        int fds[2];
+        NS_ABORT_MSG_IF(pipe(fds) != 0, "pipe failed");
+        pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "fork failed for " << count << " stations");
+        if (pid == 0)
+        {
+            close(fds[0]);
+            BenchmarkSample sample = Measure(scenarioConfig);
+            const bool written = write(fds[1], &sample, sizeof(sample)) == sizeof(sample);
+            _exit(written ? 0 : 1);
+        }
+        close(fds[1]);
+        BenchmarkSample sample{};
+        const bool received = read(fds[0], &sample, sizeof(sample)) == sizeof(sample);
+        close(fds[0]);
+        int status = 0;
+        struct rusage usage = {};
+        wait4(pid, &status, 0, &usage);
+        if (!received || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            std::cerr << "Run with " << count << " stations failed" << std::endl;
+            continue;
+        }
+
+        const double simSeconds = scenarioConfig.GetSimuTime();
+        std::ostringstream row;
+        row << n << "," << simSeconds << "," << std::fixed << std::setprecision(3)
+            << sample.buildSeconds << "," << sample.runSeconds << "," << sample.events << ","
+            << sample.events / sample.runSeconds << "," << usage.ru_maxrss << ","
+            << simSeconds / sample.runSeconds;
+        table << row.str() << std::endl;
+        std::cout << row.str() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+// Adaptive replication of a fairness scenario across run numbers.
+//
+// Runs the scenario with successive --run values, as many in parallel as
+// there are cores, until the 95% confidence interval of every metric is
+// narrower than the target width, e.g.
+//
+//   ./ns3 run "fairness-replicate
+//       --program=build/scratch/fairness/ns3.39-fairness-scenario-default
+//       --args='--config=scratch/fairness/scenarios/tcp-quic.ini --run={seed} --outputDir=.'
+//       --metrics=tcp-flow:kbps,quic-flow:kbps --width=0.05"
+//
+// Each run executes in its own result directory. Arguments naming an existing
+// file, such as the --config above, are resolved from the working directory of
+// fairness-replicate first, so they may be relative to it; other paths in
+// --args are relative to the result directory.
+//
+// A metric prefix:column is the mean of that column of the client flow over
+// the <prefix>*-totals.csv files of a run. Every run's values are listed in
+// replications.csv and the intervals in summary.csv, in --outputDir.
+
+#include "lib/replication-controller.h"
+#include "lib/sweep-runner.h"
+
+#include "ns3/core-module.h"
+
+#include <thread>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("FairnessReplicate");
+
+int
+main(int argc, char* argv[])
+{
+    std::string program;
+    std::string args = "--run={seed} --outputDir=.";
+    std::string outputDir = "replications";
+    std::string metrics = "tcp-flow:kbps,quic-flow:kbps";
+    double width = 0.05;
+    bool relative = true;
+    uint32_t minRuns = 3;
+    uint32_t maxRuns = 50;
+    uint32_t firstRun = 1;
+    uint32_t jobs = std::thread::hardware_concurrency();
+
+    CommandLine cmd;
+    cmd.AddValue("program", "Program path", program);
+    cmd.AddValue("args", "Argument template passed to every run, {seed} is the run number", args);
+    cmd.AddValue("outputDir", "Root directory of the per-run result directories", outputDir);
+    cmd.AddValue("metrics", "Comma separated prefix:column metrics", metrics);
+    cmd.AddValue("width", "Target full width of the 95% confidence intervals", width);
+    cmd.AddValue("relative", "Whether the width is relative to the mean", relative);
+    cmd.AddValue("minRuns", "Minimum number of replications", minRuns);
+    cmd.AddValue("maxRuns", "Maximum number of replications", maxRuns);
+    cmd.AddValue("firstRun", "Run number of the first replication", firstRun);
+    cmd.AddValue("jobs", "Maximum number of concurrent runs", jobs);
+    cmd.Parse(argc, argv);
+
+    LogComponentEnable("ReplicationController", LOG_LEVEL_INFO);
+    NS_ABORT_MSG_IF(program.empty(), "--program is required");
+
+    ReplicationController controller(program, args, outputDir, jobs);
+    for (const auto& metric : SplitList(metrics))
+    {
+        controller.AddMetric(ReplicationMetric::Parse(metric));
+    }
+    controller.SetStopping(width, relative, minRuns, maxRuns);
+
+    std::cout << "***Replicating up to " << maxRuns << " runs on " << jobs << " jobs***"
+              << std::endl;
+    const bool converged = controller.Run(firstRun);
+
+    for (const auto& summary : controller.GetSummaries())
+    {
+        std::cout << summary.metric << ": " << summary.mean << " +- " << summary.halfWidth
+                  << " (95% CI, n=" << summary.n << ")" << std::endl;
+    }
+    std::cout << "***" << (converged ? "Converged" : "Did not converge") << "***" << std::endl;
+
+    return converged ? 0 : 1;
+}
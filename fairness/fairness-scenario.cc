@@ -0,0 +1,47 @@
+// Config-driven WiFi fairness scenario.
+//
+// One binary for the topology that the simulation-*/base-of.cc and
+// old-simulation/* copies hard-code: TCP/QUIC/UDP STAs behind one AP, a
+// gateway and one server per protocol. Parameters come from an INI file and
+// the command line, e.g.
+//
+//   ./ns3 run "fairness-scenario --config=scratch/fairness/scenarios/tcp-quic.ini --initPos=35"
+//   ./ns3 run "fairness-scenario --mix=udp-tcp --lateStart=0.5 --run=3"
+//
+// Results land in --outputDir (a timestamped directory by default), together
+// with the effective parameters in scenario.ini. With --cache=dir, a run whose
+// parameters, attribute defaults and build match an earlier one copies that
+// run's results instead of simulating again. With --database=sweep.db, the
+// per-step metrics also go to that SQLite file, which every run of a sweep
+// can share. With --cullChannel, a transmission only reaches the WiFi PHYs
+// it can be received by, which saves events with many STAs, and with
+// --cachePropagation the loss and delay between two nodes are only computed
+// again after one of them moved. --errorTable looks the WiFi chunk success
+// rates up in tables, kept across runs with
+// --ns3::TabulatedErrorRateModel::TableFile=file.
+
+#include "lib/scenario-config.h"
+#include "lib/wifi-fairness-scenario.h"
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("FairnessScenario");
+
+int
+main(int argc, char* argv[])
+{
+    ScenarioConfig config;
+    config.Parse(argc, argv);
+
+    LogComponentEnable("NodeStatistics", LOG_LEVEL_INFO);
+
+    WifiFairnessScenario scenario(config);
+    scenario.Build();
+
+    std::cout << "***Simulation is Starting: " << scenario.GetOutputDir() << "***" << std::endl;
+    scenario.Run();
+
+    return 0;
+}
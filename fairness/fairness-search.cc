@@ -0,0 +1,83 @@
+// Adaptive search of the STA distance where a fairness metric crosses a
+// threshold.
+//
+// Instead of a dense distance grid, runs a handful of distances per round
+// inside a bracket and keeps the part where the objective crosses the
+// threshold, e.g. where TCP and QUIC get the same throughput:
+//
+//   ./ns3 run "fairness-search
+//       --program=build/scratch/fairness/ns3.39-fairness-scenario-default
+//       --args='--mix=tcp-quic --lateStart=0.5 --initPos={distance} --outputDir=.'
+//       --metric=tcp-flow:kbps --denominator=quic-flow:kbps --threshold=1
+//       --low=1 --high=60"
+//
+// or the distance where the loss rate of a flow exceeds 10%, with
+// --metric=tcp-flow:plr --threshold=10. Every run is listed in search.csv in
+// --outputDir.
+
+#include "lib/distance-search.h"
+
+#include "ns3/core-module.h"
+
+#include <thread>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("FairnessSearch");
+
+int
+main(int argc, char* argv[])
+{
+    std::string program;
+    std::string args = "--initPos={distance} --run={seed} --outputDir=.";
+    std::string outputDir = "search";
+    std::string metric = "tcp-flow:kbps";
+    std::string denominator = "";
+    double threshold = 1;
+    int low = 1;
+    int high = 60;
+    int tolerance = 1;
+    uint32_t maxRuns = 20;
+    uint32_t seed = 1;
+    uint32_t jobs = std::thread::hardware_concurrency();
+
+    CommandLine cmd;
+    cmd.AddValue("program", "Program path", program);
+    cmd.AddValue("args", "Argument template, with {distance} and {seed} placeholders", args);
+    cmd.AddValue("outputDir", "Root directory of the per-run result directories", outputDir);
+    cmd.AddValue("metric", "prefix:column metric, or the numerator of a ratio", metric);
+    cmd.AddValue("denominator", "prefix:column denominator of a ratio, none if empty", denominator);
+    cmd.AddValue("threshold", "Value of the metric or ratio whose crossing is searched", threshold);
+    cmd.AddValue("low", "Lower end of the initial distance bracket (m)", low);
+    cmd.AddValue("high", "Upper end of the initial distance bracket (m)", high);
+    cmd.AddValue("tolerance", "Final bracket width (m)", tolerance);
+    cmd.AddValue("maxRuns", "Maximum number of runs", maxRuns);
+    cmd.AddValue("seed", "Run number of every run", seed);
+    cmd.AddValue("jobs", "Runs per round", jobs);
+    cmd.Parse(argc, argv);
+
+    LogComponentEnable("DistanceSearch", LOG_LEVEL_INFO);
+    NS_ABORT_MSG_IF(program.empty(), "--program is required");
+
+    DistanceSearch search(program, args, outputDir, jobs);
+    if (denominator.empty())
+    {
+        search.SetObjective(ReplicationMetric::Parse(metric), threshold);
+    }
+    else
+    {
+        search.SetObjective(ReplicationMetric::Parse(metric),
+                            ReplicationMetric::Parse(denominator),
+                            threshold);
+    }
+    DistanceSearch::Result result = search.Run(low, high, tolerance, maxRuns, seed);
+
+    if (!result.bracketed)
+    {
+        std::cout << "***No crossing between " << low << " and " << high << " m***" << std::endl;
+        return 1;
+    }
+    std::cout << "***Crossing between " << result.low << " and " << result.high << " m, about "
+              << result.crossing << " m, after " << result.runs << " runs***" << std::endl;
+    return 0;
+}
@@ -0,0 +1,55 @@
+// Single-pass summary of the results of a sweep.
+//
+// Streams the per-step statistics and cwnd traces (CSV, text or binary)
+// below a sweep directory and writes, per run and per group of runs, the
+// count, mean, extremes and percentiles of the throughput, loss, delay,
+// jitter and cwnd of every flow, plus Jain's fairness index of every run:
+//
+//   ./ns3 run "fairness-summarize --input=sweep --percentiles=50,90,99"
+//
+// Memory does not grow with the size of the traces, so the summary of a
+// large sweep takes about as long as reading it once. The tables land in
+// summary-runs.csv and summary-groups.csv in --output, the input directory
+// by default.
+
+#include "lib/sweep-runner.h"
+#include "lib/trace-summarizer.h"
+
+#include "ns3/core-module.h"
+
+#include <thread>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("FairnessSummarize");
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+    std::string percentiles = "50,90,99";
+    uint32_t jobs = std::thread::hardware_concurrency();
+
+    CommandLine cmd;
+    cmd.AddValue("input", "Sweep directory", input);
+    cmd.AddValue("output", "Directory of the summary tables, the input directory if empty", output);
+    cmd.AddValue("percentiles", "Comma separated percentiles to report", percentiles);
+    cmd.AddValue("jobs", "Runs summarized in parallel", jobs);
+    cmd.Parse(argc, argv);
+
+    LogComponentEnable("TraceSummarizer", LOG_LEVEL_INFO);
+    NS_ABORT_MSG_IF(input.empty(), "--input is required");
+
+    std::vector<double> values;
+    for (const auto& percentile : SplitList(percentiles))
+    {
+        values.push_back(std::stod(percentile));
+    }
+
+    TraceSummarizer summarizer(input, output.empty() ? input : output, jobs);
+    summarizer.SetPercentiles(values);
+    const uint32_t runs = summarizer.Run();
+    std::cout << "***Summarized " << runs << " runs***" << std::endl;
+    return runs > 0 ? 0 : 1;
+}
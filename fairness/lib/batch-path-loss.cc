@@ -0,0 +1,207 @@
+#include "batch-path-loss.h"
+
+#include "ns3/abort.h"
+#include "ns3/double.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace ns3
+{
+
+namespace
+{
+
+/// Speed of light, as FriisPropagationLossModel (m/s).
+const double C = 299792458.0;
+
+/// Read a double attribute of a model.
+double
+GetDouble(Ptr<PropagationLossModel> loss, const std::string& name)
+{
+    DoubleValue value;
+    loss->GetAttribute(name, value);
+    return value.Get();
+}
+
+// The kernels follow the DoCalcRxPower() of their model operation by
+// operation, so the results are the same to the bit (the file is built with
+// -ffp-contract=off, see batch-path-loss-check); the branches become selects
+// so the loops are branch-free.
+
+/// FriisPropagationLossModel; param: lambda, system loss, min loss.
+void
+Friis(const std::vector<double>& param,
+      const double* __restrict distances,
+      std::size_t n,
+      double* __restrict rx)
+{
+    const double lambda = param[0];
+    const double systemLoss = param[1];
+    const double minLoss = param[2];
+    const double numerator = lambda * lambda;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const double distance = distances[i];
+        const double denominator = 16 * M_PI * M_PI * distance * distance * systemLoss;
+        const double lossDb = -10 * std::log10(numerator / denominator);
+        rx[i] = distance <= 0 ? rx[i] - minLoss : rx[i] - std::max(lossDb, minLoss);
+    }
+}
+
+/// LogDistancePropagationLossModel; param: exponent, reference distance and loss.
+void
+LogDistance(const std::vector<double>& param,
+            const double* __restrict distances,
+            std::size_t n,
+            double* __restrict rx)
+{
+    const double exponent = param[0];
+    const double referenceDistance = param[1];
+    const double referenceLoss = param[2];
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const double distance = distances[i];
+        const double pathLossDb = 10 * exponent * std::log10(distance / referenceDistance);
+        const double rxc = -referenceLoss - pathLossDb;
+        rx[i] = distance <= referenceDistance ? rx[i] - referenceLoss : rx[i] + rxc;
+    }
+}
+
+/**
+ * ThreeLogDistancePropagationLossModel; param: distance 0-2, exponent 0-2,
+ * reference loss, and the loss at distance 1 and 2.
+ */
+void
+ThreeLogDistance(const std::vector<double>& param,
+                 const double* __restrict distances,
+                 std::size_t n,
+                 double* __restrict rx)
+{
+    const double distance0 = param[0];
+    const double distance1 = param[1];
+    const double distance2 = param[2];
+    const double exponent0 = param[3];
+    const double exponent1 = param[4];
+    const double exponent2 = param[5];
+    const double referenceLoss = param[6];
+    const double loss1 = param[7];
+    const double loss2 = param[8];
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const double distance = distances[i];
+        // Field of the distance: its start, loss at the start and exponent
+        const bool far1 = distance >= distance1;
+        const bool far2 = distance >= distance2;
+        const double start = far2 ? distance2 : (far1 ? distance1 : distance0);
+        const double base = far2 ? loss2 : (far1 ? loss1 : referenceLoss);
+        const double exponent = far2 ? exponent2 : (far1 ? exponent1 : exponent0);
+        const double pathLossDb = base + 10 * exponent * std::log10(distance / start);
+        rx[i] = rx[i] - (distance < distance0 ? 0 : pathLossDb);
+    }
+}
+
+} // namespace
+
+BatchPathLoss::BatchPathLoss(Ptr<PropagationLossModel> loss)
+{
+    NS_ABORT_MSG_UNLESS(IsSupported(loss), "The loss chain has a model without batch kernel");
+    for (; loss; loss = loss->GetNext())
+    {
+        if (DynamicCast<FriisPropagationLossModel>(loss))
+        {
+            m_stages.push_back({Stage::FRIIS,
+                                {C / GetDouble(loss, "Frequency"),
+                                 GetDouble(loss, "SystemLoss"),
+                                 GetDouble(loss, "MinLoss")}});
+        }
+        else if (DynamicCast<LogDistancePropagationLossModel>(loss))
+        {
+            m_stages.push_back({Stage::LOG_DISTANCE,
+                                {GetDouble(loss, "Exponent"),
+                                 GetDouble(loss, "ReferenceDistance"),
+                                 GetDouble(loss, "ReferenceLoss")}});
+        }
+        else
+        {
+            const double distance0 = GetDouble(loss, "Distance0");
+            const double distance1 = GetDouble(loss, "Distance1");
+            const double distance2 = GetDouble(loss, "Distance2");
+            const double exponent0 = GetDouble(loss, "Exponent0");
+            const double exponent1 = GetDouble(loss, "Exponent1");
+            const double exponent2 = GetDouble(loss, "Exponent2");
+            const double referenceLoss = GetDouble(loss, "ReferenceLoss");
+            const double loss1 = referenceLoss + 10 * exponent0 * std::log10(distance1 / distance0);
+            const double loss2 = loss1 + 10 * exponent1 * std::log10(distance2 / distance1);
+            m_stages.push_back({Stage::THREE_LOG_DISTANCE,
+                                {distance0,
+                                 distance1,
+                                 distance2,
+                                 exponent0,
+                                 exponent1,
+                                 exponent2,
+                                 referenceLoss,
+                                 loss1,
+                                 loss2}});
+        }
+    }
+}
+
+bool
+BatchPathLoss::IsSupported(Ptr<PropagationLossModel> loss)
+{
+    for (; loss; loss = loss->GetNext())
+    {
+        if (!DynamicCast<FriisPropagationLossModel>(loss) &&
+            !DynamicCast<LogDistancePropagationLossModel>(loss) &&
+            !DynamicCast<ThreeLogDistancePropagationLossModel>(loss))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+BatchPathLoss::CalcDistances(const Vector& sender,
+                             const double* __restrict x,
+                             const double* __restrict y,
+                             const double* __restrict z,
+                             std::size_t n,
+                             double* __restrict distances)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const double dx = x[i] - sender.x;
+        const double dy = y[i] - sender.y;
+        const double dz = z[i] - sender.z;
+        distances[i] = std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+}
+
+void
+BatchPathLoss::CalcRxPower(double txPowerDbm,
+                           const double* distances,
+                           std::size_t n,
+                           double* rxPowerDbm) const
+{
+    std::fill(rxPowerDbm, rxPowerDbm + n, txPowerDbm);
+    for (const Stage& stage : m_stages)
+    {
+        switch (stage.type)
+        {
+        case Stage::FRIIS:
+            Friis(stage.param, distances, n, rxPowerDbm);
+            break;
+        case Stage::LOG_DISTANCE:
+            LogDistance(stage.param, distances, n, rxPowerDbm);
+            break;
+        case Stage::THREE_LOG_DISTANCE:
+            ThreeLogDistance(stage.param, distances, n, rxPowerDbm);
+            break;
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,97 @@
+#ifndef FAIRNESS_BATCH_PATH_LOSS_H
+#define FAIRNESS_BATCH_PATH_LOSS_H
+
+#include "ns3/propagation-loss-model.h"
+#include "ns3/vector.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * RX power of one transmission at many receivers, one pass over all the
+ * receivers per loss model of a chain.
+ *
+ * Built from a chain of Friis, log-distance and three log-distance models,
+ * whose parameters it copies, and gives the same RX power as
+ * PropagationLossModel::CalcRxPower() of the chain. The receivers come as
+ * packed arrays and every model is one scalar loop over them, so a pass
+ * makes one call per model of the chain instead of one virtual call, and a
+ * distance computation, per receiver and model. The loops call std::log10()
+ * per receiver and are not vectorized: vector logarithms would not give the
+ * same bits as the models.
+ */
+class BatchPathLoss
+{
+  public:
+    /**
+     * Create an empty chain, which leaves the TX power unchanged.
+     */
+    BatchPathLoss() = default;
+
+    /**
+     * \param loss The first loss model of the chain, which must be supported.
+     */
+    BatchPathLoss(Ptr<PropagationLossModel> loss);
+
+    /**
+     * \param loss The first loss model of a chain.
+     * \return True if every model of the chain is supported.
+     */
+    static bool IsSupported(Ptr<PropagationLossModel> loss);
+
+    /**
+     * Compute the distances from a sender to the receivers, as
+     * MobilityModel::GetDistanceFrom().
+     *
+     * \param sender The sender position.
+     * \param x The receiver x coordinates.
+     * \param y The receiver y coordinates.
+     * \param z The receiver z coordinates.
+     * \param n The number of receivers.
+     * \param distances The distances, n values.
+     */
+    static void CalcDistances(const Vector& sender,
+                              const double* x,
+                              const double* y,
+                              const double* z,
+                              std::size_t n,
+                              double* distances);
+
+    /**
+     * \param txPowerDbm The TX power.
+     * \param distances The distances to the receivers.
+     * \param n The number of receivers.
+     * \param rxPowerDbm The RX powers, n values.
+     */
+    void CalcRxPower(double txPowerDbm,
+                     const double* distances,
+                     std::size_t n,
+                     double* rxPowerDbm) const;
+
+  private:
+    /**
+     * A loss model of the chain, with its parameters.
+     */
+    struct Stage
+    {
+        /// Loss model type
+        enum Type
+        {
+            FRIIS,
+            LOG_DISTANCE,
+            THREE_LOG_DISTANCE
+        };
+
+        Type type;                 //!< Loss model type.
+        std::vector<double> param; //!< Parameters, by type.
+    };
+
+    std::vector<Stage> m_stages; //!< Loss models, in chain order.
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_BATCH_PATH_LOSS_H */
@@ -0,0 +1,258 @@
+#include "binary-trace.h"
+
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+
+namespace ns3
+{
+
+namespace
+{
+
+const char MAGIC[8] = {'N', 'S', '3', 'B', 'T', 'R', 'C', '\0'};
+const uint16_t VERSION = 1;
+
+template <typename T>
+void
+WriteRaw(std::ostream& os, T value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool
+ReadRaw(std::istream& is, T& value)
+{
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+} // namespace
+
+std::size_t
+GetBinaryTraceTypeSize(BinaryTraceColumn::Type type)
+{
+    switch (type)
+    {
+    case BinaryTraceColumn::TIME:
+        return sizeof(int64_t);
+    case BinaryTraceColumn::UINT32:
+        return sizeof(uint32_t);
+    case BinaryTraceColumn::DOUBLE:
+        return sizeof(double);
+    }
+    NS_FATAL_ERROR("Unknown binary trace column type " << +type);
+    return 0;
+}
+
+BinaryTraceSink::BinaryTraceSink(const std::string& fileName,
+                                 const std::vector<BinaryTraceColumn>& columns,
+                                 uint32_t blockRows)
+    : m_columns(columns),
+      m_data(columns.size()),
+      m_blockRows(blockRows)
+{
+    NS_ABORT_MSG_IF(columns.empty() || columns.size() > UINT16_MAX, "Bad trace schema");
+    m_file.open(fileName, std::ios::out | std::ios::trunc | std::ios::binary);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "Cannot open trace file " << fileName);
+
+    m_file.write(MAGIC, sizeof(MAGIC));
+    WriteRaw(m_file, VERSION);
+    WriteRaw(m_file, static_cast<uint16_t>(m_columns.size()));
+    for (std::size_t i = 0; i < m_columns.size(); i++)
+    {
+        const BinaryTraceColumn& column = m_columns[i];
+        NS_ABORT_MSG_IF(column.name.size() > UINT8_MAX, "Column name too long: " << column.name);
+        WriteRaw(m_file, static_cast<uint8_t>(column.type));
+        WriteRaw(m_file, static_cast<uint8_t>(column.name.size()));
+        m_file.write(column.name.data(), column.name.size());
+        m_data[i].reserve(m_blockRows * GetBinaryTraceTypeSize(column.type));
+    }
+}
+
+BinaryTraceSink::~BinaryTraceSink()
+{
+    Flush();
+}
+
+void
+BinaryTraceSink::Put(std::size_t column, Time value)
+{
+    Append(column, BinaryTraceColumn::TIME, value.GetNanoSeconds());
+}
+
+void
+BinaryTraceSink::Put(std::size_t column, uint32_t value)
+{
+    Append(column, BinaryTraceColumn::UINT32, value);
+}
+
+void
+BinaryTraceSink::Put(std::size_t column, double value)
+{
+    Append(column, BinaryTraceColumn::DOUBLE, value);
+}
+
+void
+BinaryTraceSink::Flush()
+{
+    if (m_rows == 0)
+    {
+        return;
+    }
+    WriteRaw(m_file, m_rows);
+    for (std::vector<char>& data : m_data)
+    {
+        m_file.write(data.data(), data.size());
+        data.clear();
+    }
+    m_file.flush();
+    m_rows = 0;
+}
+
+Ptr<BinaryTraceSink>
+CreateBinaryTraceSink(const std::string& fileName, const std::vector<BinaryTraceColumn>& columns)
+{
+    Ptr<BinaryTraceSink> sink = Create<BinaryTraceSink>(fileName, columns);
+    // The event holds a reference, so the sink lives at least until the flush
+    Simulator::ScheduleDestroy(&BinaryTraceSink::Flush, sink);
+    return sink;
+}
+
+BinaryTraceReader::BinaryTraceReader(const std::string& fileName)
+    : m_file(fileName, std::ios::in | std::ios::binary)
+{
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "Cannot open trace file " << fileName);
+
+    char magic[sizeof(MAGIC)];
+    uint16_t version = 0;
+    uint16_t nColumns = 0;
+    m_file.read(magic, sizeof(magic));
+    NS_ABORT_MSG_UNLESS(m_file && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0,
+                        fileName << " is not a binary trace");
+    NS_ABORT_MSG_UNLESS(ReadRaw(m_file, version) && version == VERSION,
+                        fileName << ": unsupported trace version " << version);
+    NS_ABORT_MSG_UNLESS(ReadRaw(m_file, nColumns), fileName << ": truncated header");
+
+    for (uint16_t i = 0; i < nColumns; i++)
+    {
+        uint8_t type = 0;
+        uint8_t length = 0;
+        NS_ABORT_MSG_UNLESS(ReadRaw(m_file, type) && ReadRaw(m_file, length),
+                            fileName << ": truncated header");
+        NS_ABORT_MSG_IF(type > BinaryTraceColumn::DOUBLE,
+                        fileName << ": unknown column type " << +type);
+        std::string name(length, '\0');
+        m_file.read(name.data(), length);
+        m_columns.push_back({name, static_cast<BinaryTraceColumn::Type>(type)});
+    }
+    m_data.resize(m_columns.size());
+}
+
+const std::vector<BinaryTraceColumn>&
+BinaryTraceReader::GetColumns() const
+{
+    return m_columns;
+}
+
+bool
+BinaryTraceReader::ReadBlock()
+{
+    m_rows = 0;
+    uint32_t rows = 0;
+    if (!ReadRaw(m_file, rows))
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < m_columns.size(); i++)
+    {
+        m_data[i].resize(rows * GetBinaryTraceTypeSize(m_columns[i].type));
+        NS_ABORT_MSG_UNLESS(m_file.read(m_data[i].data(), m_data[i].size()),
+                            "Truncated binary trace block");
+    }
+    m_rows = rows;
+    return true;
+}
+
+uint32_t
+BinaryTraceReader::GetNRows() const
+{
+    return m_rows;
+}
+
+double
+BinaryTraceReader::GetValue(std::size_t column, uint32_t row) const
+{
+    const char* data = m_data[column].data();
+    switch (m_columns[column].type)
+    {
+    case BinaryTraceColumn::TIME: {
+        int64_t ns;
+        std::memcpy(&ns, data + row * sizeof(ns), sizeof(ns));
+        return ns / 1e9;
+    }
+    case BinaryTraceColumn::UINT32: {
+        uint32_t value;
+        std::memcpy(&value, data + row * sizeof(value), sizeof(value));
+        return value;
+    }
+    case BinaryTraceColumn::DOUBLE: {
+        double value;
+        std::memcpy(&value, data + row * sizeof(value), sizeof(value));
+        return value;
+    }
+    }
+    return 0;
+}
+
+void
+BinaryTraceReader::WriteValue(std::ostream& os, std::size_t column, uint32_t row) const
+{
+    const char* data = m_data[column].data();
+    switch (m_columns[column].type)
+    {
+    case BinaryTraceColumn::TIME:
+        os << GetValue(column, row);
+        break;
+    case BinaryTraceColumn::UINT32: {
+        uint32_t value;
+        std::memcpy(&value, data + row * sizeof(value), sizeof(value));
+        os << value;
+        break;
+    }
+    case BinaryTraceColumn::DOUBLE: {
+        double value;
+        std::memcpy(&value, data + row * sizeof(value), sizeof(value));
+        const std::streamsize precision = os.precision(17);
+        os << value;
+        os.precision(precision);
+        break;
+    }
+    }
+}
+
+void
+BinaryTraceReader::WriteCsv(std::ostream& os, const std::string& separator, bool header)
+{
+    if (header)
+    {
+        for (std::size_t i = 0; i < m_columns.size(); i++)
+        {
+            os << (i ? separator : "") << m_columns[i].name;
+        }
+        os << '\n';
+    }
+    while (ReadBlock())
+    {
+        for (uint32_t row = 0; row < m_rows; row++)
+        {
+            for (std::size_t i = 0; i < m_columns.size(); i++)
+            {
+                os << (i ? separator : "");
+                WriteValue(os, i, row);
+            }
+            os << '\n';
+        }
+    }
+}
+
+} // namespace ns3
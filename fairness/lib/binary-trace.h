@@ -0,0 +1,217 @@
+#ifndef FAIRNESS_BINARY_TRACE_H
+#define FAIRNESS_BINARY_TRACE_H
+
+#include "ns3/assert.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Column of a binary trace.
+ */
+struct BinaryTraceColumn
+{
+    /// Storage type of a column.
+    enum Type : uint8_t
+    {
+        TIME = 0,   //!< Time, int64 nanoseconds, printed in seconds.
+        UINT32 = 1, //!< Unsigned 32-bit integer.
+        DOUBLE = 2, //!< IEEE 754 double.
+    };
+
+    std::string name; //!< Column name, the CSV header field.
+    Type type;        //!< Storage type.
+};
+
+/**
+ * Compact binary alternative to the per-event text traces.
+ *
+ * Rows are collected column by column and written in blocks of fixed-width
+ * values, so recording an event never formats a number. The file layout, in
+ * native (little-endian) byte order, is
+ *
+ *   "NS3BTRC" '\0'                  magic
+ *   uint16 version, uint16 nColumns
+ *   nColumns x { uint8 type, uint8 nameLength, name }
+ *   blocks of { uint32 nRows, nColumns x nRows values }
+ *
+ * BinaryTraceReader, or the trace-to-csv tool, turns it back into the text
+ * format.
+ */
+class BinaryTraceSink : public SimpleRefCount<BinaryTraceSink>
+{
+  public:
+    /// Default number of rows per block.
+    static constexpr uint32_t DEFAULT_BLOCK_ROWS = 1 << 16;
+
+    /**
+     * \param fileName The file to create, truncated if it exists.
+     * \param columns The schema.
+     * \param blockRows The number of rows per block.
+     */
+    BinaryTraceSink(const std::string& fileName,
+                    const std::vector<BinaryTraceColumn>& columns,
+                    uint32_t blockRows = DEFAULT_BLOCK_ROWS);
+    ~BinaryTraceSink();
+
+    /**
+     * Append one row. The values must match the schema in number and type.
+     *
+     * \param values The row values.
+     */
+    template <typename... Values>
+    void Write(Values... values);
+
+    /**
+     * Write the pending rows as a block.
+     */
+    void Flush();
+
+  private:
+    /**
+     * Append a value to a column.
+     *
+     * \param column The column index.
+     * \param value The value.
+     */
+    void Put(std::size_t column, Time value);
+    /// \copydoc Put(std::size_t,Time)
+    void Put(std::size_t column, uint32_t value);
+    /// \copydoc Put(std::size_t,Time)
+    void Put(std::size_t column, double value);
+
+    /**
+     * Append the raw bytes of a value to a column.
+     *
+     * \param column The column index.
+     * \param type The type of the value.
+     * \param value The value.
+     */
+    template <typename T>
+    void Append(std::size_t column, BinaryTraceColumn::Type type, T value);
+
+    std::vector<BinaryTraceColumn> m_columns; //!< Schema.
+    std::vector<std::vector<char>> m_data;    //!< Pending values, one buffer per column.
+    uint32_t m_blockRows;                     //!< Rows per block.
+    uint32_t m_rows{0};                       //!< Pending rows.
+    std::ofstream m_file;                     //!< The trace file.
+};
+
+/**
+ * Create a binary trace sink that is flushed on Simulator::Destroy.
+ *
+ * \param fileName The file to create.
+ * \param columns The schema.
+ * \return The sink.
+ */
+Ptr<BinaryTraceSink> CreateBinaryTraceSink(const std::string& fileName,
+                                           const std::vector<BinaryTraceColumn>& columns);
+
+/**
+ * Block-wise reader of BinaryTraceSink files.
+ */
+class BinaryTraceReader
+{
+  public:
+    /**
+     * \param fileName The file to read.
+     */
+    BinaryTraceReader(const std::string& fileName);
+
+    /**
+     * \return The schema.
+     */
+    const std::vector<BinaryTraceColumn>& GetColumns() const;
+
+    /**
+     * Load the next block.
+     *
+     * \return false at the end of the file.
+     */
+    bool ReadBlock();
+
+    /**
+     * \return The number of rows of the current block.
+     */
+    uint32_t GetNRows() const;
+
+    /**
+     * \param column The column index.
+     * \param row The row index in the current block.
+     * \return The value as a double, times in seconds.
+     */
+    double GetValue(std::size_t column, uint32_t row) const;
+
+    /**
+     * Write the rest of the file as text, one row per line: times in seconds
+     * at the default precision, as the legacy traces printed GetSeconds(),
+     * integers as integers and doubles with all their digits.
+     *
+     * \param os The output stream.
+     * \param separator The field separator.
+     * \param header Whether to write the column names first.
+     */
+    void WriteCsv(std::ostream& os, const std::string& separator, bool header);
+
+  private:
+    /**
+     * Write a value in its text form.
+     *
+     * \param os The output stream.
+     * \param column The column index.
+     * \param row The row index in the current block.
+     */
+    void WriteValue(std::ostream& os, std::size_t column, uint32_t row) const;
+
+    std::ifstream m_file;                     //!< The trace file.
+    std::vector<BinaryTraceColumn> m_columns; //!< Schema.
+    std::vector<std::vector<char>> m_data;    //!< Current block, one buffer per column.
+    uint32_t m_rows{0};                       //!< Rows of the current block.
+};
+
+/**
+ * \param type A column type.
+ * \return The size of a value of that type in bytes.
+ */
+std::size_t GetBinaryTraceTypeSize(BinaryTraceColumn::Type type);
+
+template <typename... Values>
+void
+BinaryTraceSink::Write(Values... values)
+{
+    NS_ASSERT_MSG(sizeof...(values) == m_columns.size(), "Row does not match the trace schema");
+    std::size_t column = 0;
+    (Put(column++, values), ...);
+    if (++m_rows == m_blockRows)
+    {
+        Flush();
+    }
+}
+
+template <typename T>
+void
+BinaryTraceSink::Append(std::size_t column,
+                        [[maybe_unused]] BinaryTraceColumn::Type type,
+                        T value)
+{
+    NS_ASSERT_MSG(m_columns[column].type == type,
+                  "Wrong type for column " << m_columns[column].name);
+    std::vector<char>& data = m_data[column];
+    const std::size_t size = data.size();
+    data.resize(size + sizeof(T));
+    std::memcpy(data.data() + size, &value, sizeof(T));
+}
+
+} // namespace ns3
+
+#endif /* FAIRNESS_BINARY_TRACE_H */
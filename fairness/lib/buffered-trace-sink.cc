@@ -0,0 +1,44 @@
+#include "buffered-trace-sink.h"
+
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+
+namespace ns3
+{
+
+BufferedTraceSink::BufferedTraceSink(const std::string& fileName, std::size_t bufferSize)
+    : m_buffer(bufferSize)
+{
+    // libstdc++ only honours the buffer if it is set before the file is opened
+    m_file.rdbuf()->pubsetbuf(m_buffer.data(), m_buffer.size());
+    m_file.open(fileName, std::ios::out | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "Cannot open trace file " << fileName);
+}
+
+BufferedTraceSink::~BufferedTraceSink()
+{
+    m_file.close();
+}
+
+std::ostream*
+BufferedTraceSink::GetStream()
+{
+    return &m_file;
+}
+
+void
+BufferedTraceSink::Flush()
+{
+    m_file.flush();
+}
+
+Ptr<BufferedTraceSink>
+CreateBufferedTraceSink(const std::string& fileName, std::size_t bufferSize)
+{
+    Ptr<BufferedTraceSink> sink = Create<BufferedTraceSink>(fileName, bufferSize);
+    // The event holds a reference, so the sink lives at least until the flush
+    Simulator::ScheduleDestroy(&BufferedTraceSink::Flush, sink);
+    return sink;
+}
+
+} // namespace ns3
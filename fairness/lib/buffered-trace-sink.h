@@ -0,0 +1,68 @@
+#ifndef FAIRNESS_BUFFERED_TRACE_SINK_H
+#define FAIRNESS_BUFFERED_TRACE_SINK_H
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Trace file that is written in large blocks.
+ *
+ * A drop-in replacement for the OutputStreamWrapper of
+ * AsciiTraceHelper::CreateFileStream for per-event traces: the stream has a
+ * private buffer of bufferSize bytes and is only written to disk when the
+ * buffer fills up, on Flush() and when the sink is destroyed. Rows must end
+ * with '\n' rather than std::endl, which would flush on every event.
+ *
+ * Sinks made with CreateBufferedTraceSink() are also flushed on
+ * Simulator::Destroy.
+ */
+class BufferedTraceSink : public SimpleRefCount<BufferedTraceSink>
+{
+  public:
+    /// Default buffer size, 1 MiB.
+    static constexpr std::size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    /**
+     * \param fileName The file to create, truncated if it exists.
+     * \param bufferSize The buffer size in bytes.
+     */
+    BufferedTraceSink(const std::string& fileName, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ~BufferedTraceSink();
+
+    /**
+     * \return The buffered stream to write rows to.
+     */
+    std::ostream* GetStream();
+
+    /**
+     * Write the buffered rows to the file.
+     */
+    void Flush();
+
+  private:
+    std::vector<char> m_buffer; //!< Stream buffer, must outlive m_file.
+    std::ofstream m_file;       //!< The trace file.
+};
+
+/**
+ * Create a buffered trace sink that is flushed on Simulator::Destroy.
+ *
+ * \param fileName The file to create.
+ * \param bufferSize The buffer size in bytes.
+ * \return The sink.
+ */
+Ptr<BufferedTraceSink> CreateBufferedTraceSink(
+    const std::string& fileName,
+    std::size_t bufferSize = BufferedTraceSink::DEFAULT_BUFFER_SIZE);
+
+} // namespace ns3
+
+#endif /* FAIRNESS_BUFFERED_TRACE_SINK_H */
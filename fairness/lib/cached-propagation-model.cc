@@ -0,0 +1,183 @@
+#include "cached-propagation-model.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CachedPropagationModel");
+
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationLossModel);
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationDelayModel);
+
+CourseChangeCounter::~CourseChangeCounter()
+{
+    Clear();
+}
+
+uint64_t
+CourseChangeCounter::GetCount(Ptr<MobilityModel> mobility)
+{
+    auto [it, inserted] = m_counts.try_emplace(PeekPointer(mobility), mobility, 0);
+    if (inserted)
+    {
+        mobility->TraceConnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&CourseChangeCounter::CourseChanged, this));
+    }
+    return it->second.second;
+}
+
+void
+CourseChangeCounter::Clear()
+{
+    for (auto& [key, count] : m_counts)
+    {
+        count.first->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&CourseChangeCounter::CourseChanged, this));
+    }
+    m_counts.clear();
+}
+
+void
+CourseChangeCounter::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    auto it = m_counts.find(PeekPointer(mobility));
+    if (it != m_counts.end())
+    {
+        it->second.second++;
+    }
+}
+
+TypeId
+CachedPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CachedPropagationLossModel>()
+            .AddAttribute("Model",
+                          "The loss model to cache, must not be random",
+                          PointerValue(),
+                          MakePointerAccessor(&CachedPropagationLossModel::m_model),
+                          MakePointerChecker<PropagationLossModel>());
+    return tid;
+}
+
+void
+CachedPropagationLossModel::SetModel(Ptr<PropagationLossModel> model)
+{
+    m_model = model;
+    m_cache.Clear();
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetModel() const
+{
+    return m_model;
+}
+
+uint64_t
+CachedPropagationLossModel::GetHits() const
+{
+    return m_cache.GetHits();
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                          Ptr<MobilityModel> a,
+                                          Ptr<MobilityModel> b) const
+{
+    NS_ASSERT(m_model);
+    return m_cache.Get(a, b, txPowerDbm, [&]() { return m_model->CalcRxPower(txPowerDbm, a, b); });
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return m_model ? m_model->AssignStreams(stream) : 0;
+}
+
+void
+CachedPropagationLossModel::DoDispose()
+{
+    NS_LOG_INFO("RX power cache: " << m_cache.GetHits() << " hits, " << m_cache.GetMisses()
+                                   << " misses");
+    m_cache.Clear();
+    m_model = nullptr;
+    PropagationLossModel::DoDispose();
+}
+
+TypeId
+CachedPropagationDelayModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedPropagationDelayModel")
+            .SetParent<PropagationDelayModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CachedPropagationDelayModel>()
+            .AddAttribute("Model",
+                          "The delay model to cache, must not be random",
+                          PointerValue(),
+                          MakePointerAccessor(&CachedPropagationDelayModel::m_model),
+                          MakePointerChecker<PropagationDelayModel>());
+    return tid;
+}
+
+void
+CachedPropagationDelayModel::SetModel(Ptr<PropagationDelayModel> model)
+{
+    m_model = model;
+    m_cache.Clear();
+}
+
+Ptr<PropagationDelayModel>
+CachedPropagationDelayModel::GetModel() const
+{
+    return m_model;
+}
+
+Time
+CachedPropagationDelayModel::GetDelay(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+    NS_ASSERT(m_model);
+    return m_cache.Get(a, b, 0, [&]() { return m_model->GetDelay(a, b); });
+}
+
+int64_t
+CachedPropagationDelayModel::DoAssignStreams(int64_t stream)
+{
+    return m_model ? m_model->AssignStreams(stream) : 0;
+}
+
+void
+CachedPropagationDelayModel::DoDispose()
+{
+    m_cache.Clear();
+    m_model = nullptr;
+    PropagationDelayModel::DoDispose();
+}
+
+void
+CachePropagationModels(Ptr<YansWifiChannel> channel)
+{
+    PointerValue loss;
+    PointerValue delay;
+    channel->GetAttribute("PropagationLossModel", loss);
+    channel->GetAttribute("PropagationDelayModel", delay);
+    NS_ABORT_MSG_UNLESS(loss.Get<PropagationLossModel>() && delay.Get<PropagationDelayModel>(),
+                        "The channel has no propagation models");
+
+    Ptr<CachedPropagationLossModel> cachedLoss = CreateObject<CachedPropagationLossModel>();
+    cachedLoss->SetModel(loss.Get<PropagationLossModel>());
+    channel->SetPropagationLossModel(cachedLoss);
+    Ptr<CachedPropagationDelayModel> cachedDelay = CreateObject<CachedPropagationDelayModel>();
+    cachedDelay->SetModel(delay.Get<PropagationDelayModel>());
+    channel->SetPropagationDelayModel(cachedDelay);
+}
+
+} // namespace ns3
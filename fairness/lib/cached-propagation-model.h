@@ -0,0 +1,269 @@
+#ifndef FAIRNESS_CACHED_PROPAGATION_MODEL_H
+#define FAIRNESS_CACHED_PROPAGATION_MODEL_H
+
+#include "ns3/mobility-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/yans-wifi-channel.h"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+namespace ns3
+{
+
+/**
+ * Counts the course changes of the mobility models it is asked about.
+ *
+ * A model is connected to on its first query; the counter disconnects from
+ * all models on Clear() or destruction.
+ */
+class CourseChangeCounter
+{
+  public:
+    ~CourseChangeCounter();
+
+    /**
+     * \param mobility A mobility model.
+     * \return The number of course changes of the model since its first query.
+     */
+    uint64_t GetCount(Ptr<MobilityModel> mobility);
+
+    /**
+     * Disconnect from and forget all models.
+     */
+    void Clear();
+
+  private:
+    /**
+     * \param mobility The model that changed course.
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    /// Counts, keyed by model
+    std::unordered_map<const MobilityModel*, std::pair<Ptr<MobilityModel>, uint64_t>> m_counts;
+};
+
+/**
+ * Values computed for ordered pairs of mobility models, valid until either
+ * model changes course.
+ *
+ * A model with a non-zero velocity moves without notifying, so pairs with
+ * such a model are always computed.
+ */
+template <typename T>
+class MobilityPairCache
+{
+  public:
+    /**
+     * \param a The first model.
+     * \param b The second model.
+     * \param key Further input of the value, e.g. the TX power; an entry of
+     * another key is a miss.
+     * \param compute Computes the value on a miss.
+     * \return The value.
+     */
+    template <typename F>
+    T Get(Ptr<MobilityModel> a, Ptr<MobilityModel> b, double key, F&& compute);
+
+    /**
+     * Drop all entries.
+     */
+    void Clear();
+
+    /**
+     * \return The number of values returned from the cache.
+     */
+    uint64_t GetHits() const;
+
+    /**
+     * \return The number of values computed.
+     */
+    uint64_t GetMisses() const;
+
+  private:
+    /// Ordered pair of models
+    using Key = std::pair<const MobilityModel*, const MobilityModel*>;
+
+    /**
+     * The value of a pair.
+     */
+    struct Entry
+    {
+        uint64_t countA; //!< Course changes of the first model.
+        uint64_t countB; //!< Course changes of the second model.
+        double key;      //!< Further input of the value.
+        T value;         //!< Value.
+    };
+
+    /**
+     * Hash of a pair of models.
+     */
+    struct PairHash
+    {
+        /**
+         * \param pair The pair.
+         * \return The hash.
+         */
+        std::size_t operator()(const Key& pair) const
+        {
+            std::hash<const void*> hash;
+            return hash(pair.first) * 31 ^ hash(pair.second);
+        }
+    };
+
+    /**
+     * \param mobility A model.
+     * \return True if the model has a non-zero velocity.
+     */
+    static bool IsMoving(Ptr<MobilityModel> mobility);
+
+    CourseChangeCounter m_counter;                      //!< Course changes of the models.
+    std::unordered_map<Key, Entry, PairHash> m_entries; //!< Values per pair.
+    uint64_t m_hits{0};                                 //!< Values returned from the cache.
+    uint64_t m_misses{0};                               //!< Values computed.
+};
+
+/**
+ * Propagation loss model that caches the RX power of another model per pair
+ * of mobility models.
+ *
+ * For the nodes of the fairness topologies, which stand still or are moved
+ * in steps, almost every frame finds the RX power of its receivers in the
+ * cache. The wrapped model, with its chain, must give the same RX power for
+ * the same positions and TX power, i.e. must not be random.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \param model The loss model to cache.
+     */
+    void SetModel(Ptr<PropagationLossModel> model);
+
+    /**
+     * \return The cached loss model.
+     */
+    Ptr<PropagationLossModel> GetModel() const;
+
+    /**
+     * \return The number of RX powers returned from the cache.
+     */
+    uint64_t GetHits() const;
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+    int64_t DoAssignStreams(int64_t stream) override;
+    void DoDispose() override;
+
+    Ptr<PropagationLossModel> m_model;         //!< Cached loss model.
+    mutable MobilityPairCache<double> m_cache; //!< RX power per pair.
+};
+
+/**
+ * Propagation delay model that caches the delay of another model per pair of
+ * mobility models. The wrapped model must not be random.
+ */
+class CachedPropagationDelayModel : public PropagationDelayModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \param model The delay model to cache.
+     */
+    void SetModel(Ptr<PropagationDelayModel> model);
+
+    /**
+     * \return The cached delay model.
+     */
+    Ptr<PropagationDelayModel> GetModel() const;
+
+    Time GetDelay(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const override;
+
+  private:
+    int64_t DoAssignStreams(int64_t stream) override;
+    void DoDispose() override;
+
+    Ptr<PropagationDelayModel> m_model;      //!< Cached delay model.
+    mutable MobilityPairCache<Time> m_cache; //!< Delay per pair.
+};
+
+/**
+ * Wrap the loss and delay models of a channel in the caching models.
+ *
+ * \param channel The channel, with its propagation models set.
+ */
+void CachePropagationModels(Ptr<YansWifiChannel> channel);
+
+template <typename T>
+template <typename F>
+T
+MobilityPairCache<T>::Get(Ptr<MobilityModel> a, Ptr<MobilityModel> b, double key, F&& compute)
+{
+    if (IsMoving(a) || IsMoving(b))
+    {
+        m_misses++;
+        return compute();
+    }
+    const uint64_t countA = m_counter.GetCount(a);
+    const uint64_t countB = m_counter.GetCount(b);
+    auto [it, inserted] = m_entries.try_emplace({PeekPointer(a), PeekPointer(b)});
+    Entry& entry = it->second;
+    if (!inserted && entry.countA == countA && entry.countB == countB && entry.key == key)
+    {
+        m_hits++;
+        return entry.value;
+    }
+    m_misses++;
+    entry = {countA, countB, key, compute()};
+    return entry.value;
+}
+
+template <typename T>
+void
+MobilityPairCache<T>::Clear()
+{
+    m_entries.clear();
+    m_counter.Clear();
+}
+
+template <typename T>
+uint64_t
+MobilityPairCache<T>::GetHits() const
+{
+    return m_hits;
+}
+
+template <typename T>
+uint64_t
+MobilityPairCache<T>::GetMisses() const
+{
+    return m_misses;
+}
+
+template <typename T>
+bool
+MobilityPairCache<T>::IsMoving(Ptr<MobilityModel> mobility)
+{
+    const Vector velocity = mobility->GetVelocity();
+    return velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+}
+
+} // namespace ns3
+
+#endif /* FAIRNESS_CACHED_PROPAGATION_MODEL_H */
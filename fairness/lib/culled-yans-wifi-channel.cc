@@ -0,0 +1,504 @@
+#include "culled-yans-wifi-channel.h"
+
+#include "cached-propagation-model.h"
+
+#include "ns3/abort.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-ppdu.h"
+#include "ns3/wifi-utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CulledYansWifiChannel");
+
+NS_OBJECT_ENSURE_REGISTERED(CulledYansWifiChannel);
+NS_OBJECT_ENSURE_REGISTERED(CulledYansWifiPhy);
+
+namespace
+{
+
+/// Distance past which the loss is not searched any further (m).
+const double MAX_RANGE = 1e7;
+
+} // namespace
+
+TypeId
+CulledYansWifiChannel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CulledYansWifiChannel")
+            .SetParent<YansWifiChannel>()
+            .SetGroupName("Wifi")
+            .AddConstructor<CulledYansWifiChannel>()
+            .AddAttribute("CellSize",
+                          "Side of the square cells of the receiver grid (m)",
+                          DoubleValue(100),
+                          MakeDoubleAccessor(&CulledYansWifiChannel::m_cellSize),
+                          MakeDoubleChecker<double>(1))
+            .AddAttribute("CullMargin",
+                          "How far below the lowest RX sensitivity of the receivers the "
+                          "signal must be for a receiver to be skipped (dB)",
+                          DoubleValue(3),
+                          MakeDoubleAccessor(&CulledYansWifiChannel::m_cullMargin),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("InterferenceRange",
+                          "Distance beyond which the transmissions of a cell do not reach the "
+                          "receivers outside of it (m), only the culling range if 0",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&CulledYansWifiChannel::m_interferenceRange),
+                          MakeDoubleChecker<double>(0));
+    return tid;
+}
+
+CulledYansWifiChannel::CulledYansWifiChannel()
+    : m_floorDbm(std::numeric_limits<double>::infinity()),
+      m_origin(CreateObject<ConstantPositionMobilityModel>()),
+      m_probe(CreateObject<ConstantPositionMobilityModel>())
+{
+}
+
+void
+CulledYansWifiChannel::SendInRange(Ptr<YansWifiPhy> sender,
+                                   Ptr<const WifiPpdu> ppdu,
+                                   double txPowerDbm)
+{
+    NS_LOG_FUNCTION(this << sender << ppdu << txPowerDbm);
+    SyncReceivers();
+    Ptr<MobilityModel> senderMobility = sender->GetMobility();
+    NS_ASSERT(senderMobility);
+
+    const double range = GetRange(txPowerDbm);
+    // The receivers outside of the cell of the sender only get the signal
+    // within the interference range
+    const uint32_t senderCell = m_receivers[m_indices.at(PeekPointer(sender))].cellId;
+    const double crossRange =
+        senderCell && m_interferenceRange > 0 ? std::min(range, m_interferenceRange) : range;
+    m_candidates.clear();
+    if (std::isinf(crossRange))
+    {
+        for (uint32_t i = 0; i < m_receivers.size(); i++)
+        {
+            m_candidates.push_back(i);
+        }
+    }
+    else
+    {
+        const Vector position = senderMobility->GetPosition();
+        const int64_t x = GetCellIndex(position.x);
+        const int64_t y = GetCellIndex(position.y);
+        const int64_t reach = static_cast<int64_t>(std::ceil(crossRange / m_cellSize));
+        const double span = 2.0 * reach + 1;
+        if (span * span > m_cells.size())
+        {
+            // Fewer occupied cells than cells in range
+            for (const auto& [cell, members] : m_cells)
+            {
+                if (std::abs((cell >> 32) - x) <= reach &&
+                    std::abs(static_cast<int32_t>(cell) - y) <= reach)
+                {
+                    m_candidates.insert(m_candidates.end(), members.begin(), members.end());
+                }
+            }
+        }
+        else
+        {
+            for (int64_t i = x - reach; i <= x + reach; i++)
+            {
+                for (int64_t j = y - reach; j <= y + reach; j++)
+                {
+                    auto it = m_cells.find(GetCell(i, j));
+                    if (it != m_cells.end())
+                    {
+                        m_candidates.insert(m_candidates.end(),
+                                            it->second.begin(),
+                                            it->second.end());
+                    }
+                }
+            }
+        }
+        m_candidates.insert(m_candidates.end(), m_moving.begin(), m_moving.end());
+        if (crossRange < range)
+        {
+            // The members of the cell come from its own list instead
+            const std::vector<uint32_t>& members = m_cellMembers[senderCell - 1];
+            m_candidates.erase(std::remove_if(m_candidates.begin(),
+                                              m_candidates.end(),
+                                              [&](uint32_t index) {
+                                                  return m_receivers[index].cellId == senderCell;
+                                              }),
+                               m_candidates.end());
+            m_candidates.insert(m_candidates.end(), members.begin(), members.end());
+        }
+        // Same event order as YansWifiChannel
+        std::sort(m_candidates.begin(), m_candidates.end());
+    }
+
+    // Pack the positions of the receivers on the channel of the sender
+    m_targets.clear();
+    m_limits.clear();
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    for (uint32_t index : m_candidates)
+    {
+        const Receiver& receiver = m_receivers[index];
+        // For now don't account for inter channel interference nor channel bonding
+        if (receiver.phy == sender ||
+            receiver.phy->GetChannelNumber() != sender->GetChannelNumber())
+        {
+            continue;
+        }
+        const Vector position =
+            receiver.moving ? receiver.mobility->GetPosition() : receiver.position;
+        m_targets.push_back(index);
+        m_limits.push_back(receiver.cellId == senderCell ? range : crossRange);
+        m_x.push_back(position.x);
+        m_y.push_back(position.y);
+        m_z.push_back(position.z);
+    }
+    m_distances.resize(m_targets.size());
+    BatchPathLoss::CalcDistances(senderMobility->GetPosition(),
+                                 m_x.data(),
+                                 m_y.data(),
+                                 m_z.data(),
+                                 m_targets.size(),
+                                 m_distances.data());
+
+    // Drop the receivers out of range
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < m_targets.size(); i++)
+    {
+        if (m_distances[i] <= m_limits[i])
+        {
+            m_targets[n] = m_targets[i];
+            m_distances[n] = m_distances[i];
+            n++;
+        }
+    }
+    m_targets.resize(n);
+    m_distances.resize(n);
+
+    m_rxPowers.resize(n);
+    if (m_batched)
+    {
+        m_batchLoss.CalcRxPower(txPowerDbm, m_distances.data(), n, m_rxPowers.data());
+    }
+    else
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            m_rxPowers[i] = m_loss->CalcRxPower(txPowerDbm,
+                                                senderMobility,
+                                                m_receivers[m_targets[i]].mobility);
+        }
+    }
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const Receiver& receiver = m_receivers[m_targets[i]];
+        Time delay = m_speed > 0 ? Seconds(m_distances[i] / m_speed)
+                                 : m_delay->GetDelay(senderMobility, receiver.mobility);
+        NS_LOG_DEBUG("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << m_rxPowers[i]
+                                             << "dbm, distance=" << m_distances[i]
+                                             << "m, delay=" << delay);
+        Simulator::ScheduleWithContext(receiver.nodeId,
+                                       delay,
+                                       &CulledYansWifiChannel::Receive,
+                                       receiver.phy,
+                                       ppdu->Copy(),
+                                       m_rxPowers[i]);
+    }
+}
+
+uint32_t
+CulledYansWifiChannel::AddCell(const NetDeviceContainer& devices)
+{
+    NS_LOG_FUNCTION(this << devices.GetN());
+    m_cellMembers.emplace_back();
+    const uint32_t cellId = m_cellMembers.size();
+    for (auto it = devices.Begin(); it != devices.End(); ++it)
+    {
+        const bool added = m_deviceCells.emplace(PeekPointer(*it), cellId).second;
+        NS_ABORT_MSG_UNLESS(added, "Device " << *it << " is already in a cell");
+    }
+    // Receivers registered before the cell
+    for (uint32_t index = 0; index < m_receivers.size(); index++)
+    {
+        if (!m_receivers[index].cellId)
+        {
+            Join(index);
+        }
+    }
+    return cellId;
+}
+
+void
+CulledYansWifiChannel::SyncReceivers()
+{
+    if (!m_loss)
+    {
+        PointerValue loss;
+        PointerValue delay;
+        GetAttribute("PropagationLossModel", loss);
+        GetAttribute("PropagationDelayModel", delay);
+        m_loss = loss.Get<PropagationLossModel>();
+        m_delay = delay.Get<PropagationDelayModel>();
+        NS_ABORT_MSG_UNLESS(m_loss && m_delay, "The channel has no propagation models");
+        // Probe the range on the cached model itself
+        Ptr<CachedPropagationLossModel> cached = DynamicCast<CachedPropagationLossModel>(m_loss);
+        m_rangeLoss = cached && !cached->GetNext() ? cached->GetModel() : m_loss;
+        m_distanceOnly = IsDistanceOnly(m_rangeLoss);
+        // Batch the loss and delay of the models with a closed form
+        m_batched = BatchPathLoss::IsSupported(m_loss);
+        if (m_batched)
+        {
+            m_batchLoss = BatchPathLoss(m_loss);
+        }
+        if (DynamicCast<ConstantSpeedPropagationDelayModel>(m_delay))
+        {
+            DoubleValue speed;
+            m_delay->GetAttribute("Speed", speed);
+            m_speed = speed.Get();
+        }
+        NS_LOG_INFO("Culling " << (m_distanceOnly ? "enabled"
+                                                  : "disabled, the loss is not distance only"));
+    }
+
+    // The PHYs of the channel are only exposed through their devices, one
+    // entry per PHY, so a device with several PHYs on the channel comes back
+    for (; m_devices < GetNDevices(); m_devices++)
+    {
+        Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(GetDevice(m_devices));
+        NS_ABORT_MSG_UNLESS(device, "Channel device " << m_devices << " is not a WiFi device");
+        for (Ptr<WifiPhy> wifiPhy : device->GetPhys())
+        {
+            Ptr<YansWifiPhy> phy = DynamicCast<YansWifiPhy>(wifiPhy);
+            if (!phy || phy->GetChannel() != this || m_indices.count(PeekPointer(phy)))
+            {
+                continue;
+            }
+            const uint32_t index = m_receivers.size();
+            m_receivers.push_back(
+                {phy, phy->GetMobility(), device->GetNode()->GetId(), false, 0, Vector(), 0});
+            m_indices[PeekPointer(phy)] = index;
+            Join(index);
+            NS_ASSERT(m_receivers.back().mobility);
+            m_receivers.back().mobility->TraceConnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&CulledYansWifiChannel::CourseChanged, this).Bind(index));
+            Place(index);
+
+            const double floorDbm = phy->GetRxSensitivity() - phy->GetRxGain();
+            if (floorDbm < m_floorDbm)
+            {
+                m_floorDbm = floorDbm;
+                m_ranges.clear();
+            }
+        }
+    }
+}
+
+void
+CulledYansWifiChannel::Join(uint32_t index)
+{
+    Receiver& receiver = m_receivers[index];
+    auto it = m_deviceCells.find(PeekPointer(receiver.phy->GetDevice()));
+    if (it != m_deviceCells.end())
+    {
+        receiver.cellId = it->second;
+        m_cellMembers[receiver.cellId - 1].push_back(index);
+    }
+}
+
+void
+CulledYansWifiChannel::Place(uint32_t index)
+{
+    Receiver& receiver = m_receivers[index];
+    const Vector velocity = receiver.mobility->GetVelocity();
+    receiver.moving = velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+    if (receiver.moving)
+    {
+        m_moving.push_back(index);
+        return;
+    }
+    receiver.position = receiver.mobility->GetPosition();
+    receiver.cell = GetCell(GetCellIndex(receiver.position.x), GetCellIndex(receiver.position.y));
+    m_cells[receiver.cell].push_back(index);
+}
+
+void
+CulledYansWifiChannel::Unplace(uint32_t index)
+{
+    const Receiver& receiver = m_receivers[index];
+    if (receiver.moving)
+    {
+        m_moving.erase(std::find(m_moving.begin(), m_moving.end(), index));
+        return;
+    }
+    auto it = m_cells.find(receiver.cell);
+    it->second.erase(std::find(it->second.begin(), it->second.end(), index));
+    if (it->second.empty())
+    {
+        m_cells.erase(it);
+    }
+}
+
+void
+CulledYansWifiChannel::CourseChanged(uint32_t index, Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << index << mobility->GetPosition());
+    Unplace(index);
+    Place(index);
+}
+
+int64_t
+CulledYansWifiChannel::GetCell(int64_t x, int64_t y)
+{
+    return static_cast<int64_t>((static_cast<uint64_t>(x) << 32) | static_cast<uint32_t>(y));
+}
+
+int64_t
+CulledYansWifiChannel::GetCellIndex(double coordinate) const
+{
+    return static_cast<int64_t>(std::floor(coordinate / m_cellSize));
+}
+
+double
+CulledYansWifiChannel::GetRange(double txPowerDbm)
+{
+    if (!m_distanceOnly)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    auto it = m_ranges.find(txPowerDbm);
+    if (it != m_ranges.end())
+    {
+        return it->second;
+    }
+
+    const double thresholdDbm = m_floorDbm - m_cullMargin;
+    auto isAbove = [&](double distance) {
+        m_probe->SetPosition(Vector(distance, 0, 0));
+        return m_rangeLoss->CalcRxPower(txPowerDbm, m_origin, m_probe) >= thresholdDbm;
+    };
+    // The loss never decreases with the distance: find the first distance
+    // below the threshold, then narrow it down
+    double near = 0;
+    double far = 1;
+    while (far < MAX_RANGE && isAbove(far))
+    {
+        near = far;
+        far *= 2;
+    }
+    double range = std::numeric_limits<double>::infinity();
+    if (far < MAX_RANGE)
+    {
+        while (far - near > 0.01)
+        {
+            const double middle = (near + far) / 2;
+            if (isAbove(middle))
+            {
+                near = middle;
+            }
+            else
+            {
+                far = middle;
+            }
+        }
+        range = far;
+    }
+    NS_LOG_INFO("Range at " << txPowerDbm << " dBm: " << range << " m");
+    m_ranges[txPowerDbm] = range;
+    return range;
+}
+
+bool
+CulledYansWifiChannel::IsDistanceOnly(Ptr<PropagationLossModel> loss)
+{
+    for (; loss; loss = loss->GetNext())
+    {
+        if (!DynamicCast<FriisPropagationLossModel>(loss) &&
+            !DynamicCast<LogDistancePropagationLossModel>(loss) &&
+            !DynamicCast<ThreeLogDistancePropagationLossModel>(loss) &&
+            !DynamicCast<RangePropagationLossModel>(loss) && !DynamicCast<FixedRssLossModel>(loss))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+CulledYansWifiChannel::Receive(Ptr<YansWifiPhy> phy, Ptr<const WifiPpdu> ppdu, double rxPowerDbm)
+{
+    NS_LOG_FUNCTION(phy << ppdu << rxPowerDbm);
+    // Do no further processing if signal is too weak
+    const auto txWidth = ppdu->GetTransmissionChannelWidth();
+    if ((rxPowerDbm + phy->GetRxGain()) < phy->GetRxSensitivity() + RatioToDb(txWidth / 20.0))
+    {
+        NS_LOG_INFO("Received signal too weak to process: " << rxPowerDbm << " dBm");
+        return;
+    }
+    RxPowerWattPerChannelBand rxPowerW;
+    // Dummy band for YANS
+    rxPowerW.emplace(RxPowerWattPerChannelBand::key_type{}, DbmToW(rxPowerDbm + phy->GetRxGain()));
+    phy->StartReceivePreamble(ppdu, rxPowerW, ppdu->GetTxDuration());
+}
+
+TypeId
+CulledYansWifiPhy::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::CulledYansWifiPhy")
+                            .SetParent<YansWifiPhy>()
+                            .SetGroupName("Wifi")
+                            .AddConstructor<CulledYansWifiPhy>();
+    return tid;
+}
+
+void
+CulledYansWifiPhy::StartTx(Ptr<const WifiPpdu> ppdu)
+{
+    Ptr<CulledYansWifiChannel> channel = DynamicCast<CulledYansWifiChannel>(GetChannel());
+    if (!channel)
+    {
+        YansWifiPhy::StartTx(ppdu);
+        return;
+    }
+    NS_LOG_FUNCTION(this << ppdu);
+    channel->SendInRange(this, ppdu, GetTxPowerForTransmission(ppdu) + GetTxGain());
+}
+
+Ptr<CulledYansWifiChannel>
+CulledYansWifiPhyHelper::SetCulledChannel(const YansWifiChannelHelper& channelHelper)
+{
+    // The helper only builds plain channels; take over their models
+    Ptr<YansWifiChannel> plain = channelHelper.Create();
+    PointerValue loss;
+    PointerValue delay;
+    plain->GetAttribute("PropagationLossModel", loss);
+    plain->GetAttribute("PropagationDelayModel", delay);
+
+    Ptr<CulledYansWifiChannel> channel = CreateObject<CulledYansWifiChannel>();
+    channel->SetPropagationLossModel(loss.Get<PropagationLossModel>());
+    channel->SetPropagationDelayModel(delay.Get<PropagationDelayModel>());
+    SetChannel(channel);
+    for (ObjectFactory& phy : m_phy)
+    {
+        phy.SetTypeId("ns3::CulledYansWifiPhy");
+    }
+    return channel;
+}
+
+} // namespace ns3
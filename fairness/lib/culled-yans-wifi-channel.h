@@ -0,0 +1,243 @@
+#ifndef FAIRNESS_CULLED_YANS_WIFI_CHANNEL_H
+#define FAIRNESS_CULLED_YANS_WIFI_CHANNEL_H
+
+#include "batch-path-loss.h"
+
+#include "ns3/mobility-model.h"
+#include "ns3/net-device-container.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/yans-wifi-channel.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/yans-wifi-phy.h"
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * YansWifiChannel that only delivers a transmission to the PHYs that can
+ * receive it.
+ *
+ * YansWifiChannel schedules a receive event on every other PHY of the
+ * channel, and the receiver drops the signal right away if it is below its
+ * RX sensitivity. When the loss models of the channel only depend on the
+ * distance and never grow with it (Friis, log-distance, three log-distance,
+ * range, fixed RSS), this channel finds the distance beyond which a
+ * transmission of the given power ends CullMargin below the lowest
+ * sensitivity of the receivers, and skips the receivers further away. Those
+ * would have dropped the signal without any other effect, so the results do
+ * not change. With any other loss model, every receiver is visited. A
+ * CachedPropagationLossModel is looked through.
+ *
+ * Receivers are kept in a grid of CellSize square cells, updated on the
+ * CourseChange of their mobility model, so a transmission only visits the
+ * cells within range. Receivers with a non-zero velocity move between
+ * notifications and are checked on every transmission.
+ *
+ * The positions of the receivers in range are packed, and with Friis,
+ * log-distance and three log-distance losses and a constant speed delay the
+ * RX powers and delays come from one BatchPathLoss pass instead of calls to
+ * the models per receiver.
+ *
+ * Several BSSs can share the channel as cells, see AddCell(). A cell keeps
+ * the list of its receivers, which get every transmission of a member in
+ * range, and the receivers of the other cells are only searched in the grid
+ * up to InterferenceRange, so co-channel interference between the cells is
+ * modelled without every frame visiting every PHY of the channel. With the
+ * default InterferenceRange of 0, or one beyond the culling range, the cells
+ * change nothing: every receiver within the culling range gets the frame,
+ * as on one all-to-all channel, and the cell lists are not used.
+ *
+ * Only CulledYansWifiPhy transmits through the grid; CulledYansWifiPhyHelper
+ * sets both up. The propagation models must be set before the first
+ * transmission.
+ */
+class CulledYansWifiChannel : public YansWifiChannel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    CulledYansWifiChannel();
+
+    /**
+     * Deliver a PPDU to the receivers in range, as YansWifiChannel::Send().
+     *
+     * \param sender The transmitting PHY.
+     * \param ppdu The PPDU.
+     * \param txPowerDbm The TX power, antenna gain included.
+     */
+    void SendInRange(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double txPowerDbm);
+
+    /**
+     * Make the devices a cell of the channel, e.g. an AP and its stations.
+     *
+     * The transmissions of a member reach the other members within the
+     * culling range, and the receivers outside of the cell only within
+     * InterferenceRange, if set. Transmissions of PHYs outside of any cell
+     * reach every receiver within the culling range.
+     *
+     * \param devices The WiFi devices of the cell, attached to the channel
+     * or to be attached to it.
+     * \return The cell ID, from 1.
+     */
+    uint32_t AddCell(const NetDeviceContainer& devices);
+
+  private:
+    /**
+     * A PHY of the channel.
+     */
+    struct Receiver
+    {
+        Ptr<YansWifiPhy> phy;        //!< PHY.
+        Ptr<MobilityModel> mobility; //!< Mobility model of the PHY.
+        uint32_t nodeId;             //!< Node of the PHY, the event context.
+        bool moving;                 //!< True if outside of the grid.
+        int64_t cell;                //!< Grid cell, unless moving.
+        Vector position;             //!< Position, unless moving.
+        uint32_t cellId;             //!< Cell of the PHY, 0 if none.
+    };
+
+    /**
+     * Register the PHYs added to the channel since the last call, and fetch
+     * the propagation models on the first call.
+     */
+    void SyncReceivers();
+
+    /**
+     * Put a receiver in the cell of its device, if any.
+     *
+     * \param index The receiver index.
+     */
+    void Join(uint32_t index);
+
+    /**
+     * Put a receiver in the grid cell of its position, or in the moving set.
+     *
+     * \param index The receiver index.
+     */
+    void Place(uint32_t index);
+
+    /**
+     * Take a receiver out of its grid cell or of the moving set.
+     *
+     * \param index The receiver index.
+     */
+    void Unplace(uint32_t index);
+
+    /**
+     * \param index The receiver index, bound at connection.
+     * \param mobility The mobility model of the receiver.
+     */
+    void CourseChanged(uint32_t index, Ptr<const MobilityModel> mobility);
+
+    /**
+     * \param x The cell column.
+     * \param y The cell row.
+     * \return The grid key of the cell.
+     */
+    static int64_t GetCell(int64_t x, int64_t y);
+
+    /**
+     * \param coordinate A position coordinate.
+     * \return The column or row of the coordinate.
+     */
+    int64_t GetCellIndex(double coordinate) const;
+
+    /**
+     * \param txPowerDbm The TX power.
+     * \return The distance beyond which no receiver gets the signal, infinite
+     * if the loss models do not allow culling.
+     */
+    double GetRange(double txPowerDbm);
+
+    /**
+     * \param loss The first loss model of the chain.
+     * \return True if every model of the chain only depends on the distance
+     * and never grows with it.
+     */
+    static bool IsDistanceOnly(Ptr<PropagationLossModel> loss);
+
+    /**
+     * Receive a PPDU, as YansWifiChannel::Receive().
+     *
+     * \param phy The receiving PHY.
+     * \param ppdu The PPDU.
+     * \param rxPowerDbm The RX power, before the RX antenna gain.
+     */
+    static void Receive(Ptr<YansWifiPhy> phy, Ptr<const WifiPpdu> ppdu, double rxPowerDbm);
+
+    double m_cellSize;                                          //!< Side of a grid cell (m).
+    double m_cullMargin;                                        //!< Culling margin (dB).
+    double m_interferenceRange;                                 //!< Cross-cell range, 0 if none.
+    Ptr<PropagationLossModel> m_loss;                           //!< Loss models of the channel.
+    Ptr<PropagationDelayModel> m_delay;                         //!< Delay model of the channel.
+    Ptr<PropagationLossModel> m_rangeLoss;                      //!< Loss models to find the range.
+    bool m_distanceOnly{false};                                 //!< True if culling is possible.
+    bool m_batched{false};                                      //!< True if m_batchLoss is used.
+    BatchPathLoss m_batchLoss;                                  //!< Batch form of the loss models.
+    double m_speed{0};                                          //!< Constant delay speed, or 0.
+    double m_floorDbm;                                          //!< Lowest sensitivity - RX gain.
+    std::map<double, double> m_ranges;                          //!< Range per TX power.
+    Ptr<MobilityModel> m_origin;                                //!< Range probe at the origin.
+    Ptr<MobilityModel> m_probe;                                 //!< Range probe on the x axis.
+    std::vector<Receiver> m_receivers;                          //!< Receivers, in added order.
+    std::size_t m_devices{0};                                   //!< Channel entries synced.
+    std::unordered_map<int64_t, std::vector<uint32_t>> m_cells; //!< Receivers per grid cell.
+    std::vector<uint32_t> m_moving;                             //!< Receivers outside of the grid.
+    std::unordered_map<const YansWifiPhy*, uint32_t> m_indices; //!< Receiver index per PHY.
+    std::map<const NetDevice*, uint32_t> m_deviceCells;         //!< Cell ID per device.
+    std::vector<std::vector<uint32_t>> m_cellMembers;           //!< Receivers per cell ID - 1.
+    std::vector<uint32_t> m_candidates;                         //!< Receivers of the current send.
+    std::vector<uint32_t> m_targets;                            //!< Candidates on the channel.
+    std::vector<double> m_x;                                    //!< X of the targets.
+    std::vector<double> m_y;                                    //!< Y of the targets.
+    std::vector<double> m_z;                                    //!< Z of the targets.
+    std::vector<double> m_distances;                            //!< Distance to the targets.
+    std::vector<double> m_limits;                               //!< Range of the targets.
+    std::vector<double> m_rxPowers;                             //!< RX power at the targets.
+};
+
+/**
+ * YansWifiPhy that transmits through CulledYansWifiChannel::SendInRange()
+ * when attached to a CulledYansWifiChannel, and as YansWifiPhy otherwise.
+ */
+class CulledYansWifiPhy : public YansWifiPhy
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    void StartTx(Ptr<const WifiPpdu> ppdu) override;
+};
+
+/**
+ * YansWifiPhyHelper that can install the PHYs on a CulledYansWifiChannel.
+ */
+class CulledYansWifiPhyHelper : public YansWifiPhyHelper
+{
+  public:
+    /**
+     * Create a CulledYansWifiChannel with the propagation models of a channel
+     * helper, attach the PHYs to it and install them as CulledYansWifiPhy.
+     *
+     * \param channelHelper The channel helper.
+     * \return The channel.
+     */
+    Ptr<CulledYansWifiChannel> SetCulledChannel(const YansWifiChannelHelper& channelHelper);
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_CULLED_YANS_WIFI_CHANNEL_H */
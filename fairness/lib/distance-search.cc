@@ -0,0 +1,175 @@
+#include "distance-search.h"
+
+#include "sweep-runner.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <sstream>
+#include <sys/wait.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("DistanceSearch");
+
+DistanceSearch::DistanceSearch(std::string program,
+                               std::string args,
+                               std::string outputDir,
+                               uint32_t jobs)
+    : m_program(std::filesystem::absolute(program).string()),
+      m_args(args),
+      m_outputDir(outputDir),
+      m_jobs(jobs > 0 ? jobs : 1)
+{
+}
+
+void
+DistanceSearch::SetObjective(const ReplicationMetric& metric, double threshold)
+{
+    m_metrics = {metric};
+    m_threshold = threshold;
+}
+
+void
+DistanceSearch::SetObjective(const ReplicationMetric& numerator,
+                             const ReplicationMetric& denominator,
+                             double threshold)
+{
+    m_metrics = {numerator, denominator};
+    m_threshold = threshold;
+}
+
+void
+DistanceSearch::Evaluate(const std::vector<int>& distances, uint32_t seed)
+{
+    std::map<pid_t, int> running;
+    for (int distance : distances)
+    {
+        SweepPoint point{"", std::to_string(distance), "", "", seed};
+        const std::string runDir = m_outputDir + "/" + point.distance + "m";
+        std::filesystem::create_directories(runDir);
+        std::vector<std::string> args = {m_program};
+        std::istringstream argStream(SweepRunner::Expand(m_args, point));
+        for (std::string arg; argStream >> arg;)
+        {
+            args.push_back(arg);
+        }
+        running[LaunchProcess(args, runDir)] = distance;
+    }
+
+    while (!running.empty())
+    {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0)
+        {
+            break;
+        }
+        auto it = running.find(pid);
+        if (it == running.end())
+        {
+            continue;
+        }
+        const int distance = it->second;
+        running.erase(it);
+
+        const std::string runDir = m_outputDir + "/" + std::to_string(distance) + "m";
+        const int exitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+        double objective = std::numeric_limits<double>::quiet_NaN();
+        if (exitStatus == 0)
+        {
+            objective = m_metrics[0].Read(runDir);
+            if (m_metrics.size() > 1)
+            {
+                objective /= m_metrics[1].Read(runDir);
+            }
+        }
+        const double value = std::isfinite(objective) ? objective - m_threshold
+                                                      : std::numeric_limits<double>::quiet_NaN();
+        m_values[distance] = value;
+        NS_LOG_INFO("Distance " << distance << " m: objective " << objective);
+        m_index << distance << "," << exitStatus << "," << objective << "," << runDir
+                << std::endl;
+    }
+}
+
+DistanceSearch::Result
+DistanceSearch::Run(int low, int high, int tolerance, uint32_t maxRuns, uint32_t seed)
+{
+    NS_ABORT_MSG_IF(m_metrics.empty(), "No search objective");
+    NS_ABORT_MSG_IF(low >= high, "Empty distance bracket");
+    NS_ABORT_MSG_IF(maxRuns < 2, "The bracket ends alone take two runs");
+
+    std::filesystem::create_directories(m_outputDir);
+    m_index.open(m_outputDir + "/search.csv");
+    m_index << "distance,status,objective,run_dir" << std::endl;
+
+    Result result{low, high, std::numeric_limits<double>::quiet_NaN(), 0, false};
+    Evaluate({low, high}, seed);
+    result.runs = 2;
+    auto below = [](double value) { return value < 0; };
+    const double lowValue = m_values[low];
+    const double highValue = m_values[high];
+    if (std::isnan(lowValue) || std::isnan(highValue) || below(lowValue) == below(highValue))
+    {
+        NS_LOG_WARN("The objective does not cross the threshold between " << low << " and "
+                                                                          << high << " m");
+        return result;
+    }
+    result.bracketed = true;
+
+    while (result.high - result.low > tolerance && result.runs < maxRuns)
+    {
+        const int width = result.high - result.low;
+        const int k = std::min<int>({int(m_jobs), int(maxRuns - result.runs), width - 1});
+        std::vector<int> distances;
+        for (int i = 1; i <= k; i++)
+        {
+            const int distance = result.low + int(std::lround(double(width) * i / (k + 1)));
+            if (distance > result.low && distance < result.high && !m_values.count(distance) &&
+                (distances.empty() || distances.back() != distance))
+            {
+                distances.push_back(distance);
+            }
+        }
+        if (distances.empty())
+        {
+            break;
+        }
+        Evaluate(distances, seed);
+        result.runs += distances.size();
+
+        // Keep the first sub-interval with a sign change, skipping failed runs
+        int previous = result.low;
+        for (auto it = m_values.upper_bound(result.low);
+             it != m_values.end() && it->first <= result.high;
+             ++it)
+        {
+            if (std::isnan(it->second))
+            {
+                continue;
+            }
+            if (below(it->second) != below(m_values[previous]))
+            {
+                result.low = previous;
+                result.high = it->first;
+                break;
+            }
+            previous = it->first;
+        }
+        NS_LOG_INFO("Bracket [" << result.low << ", " << result.high << "] m after "
+                                << result.runs << " runs");
+    }
+
+    const double a = m_values[result.low];
+    const double b = m_values[result.high];
+    result.crossing = result.low + (result.high - result.low) * a / (a - b);
+    return result;
+}
+
+} // namespace ns3
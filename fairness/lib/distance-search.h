@@ -0,0 +1,97 @@
+#ifndef FAIRNESS_DISTANCE_SEARCH_H
+#define FAIRNESS_DISTANCE_SEARCH_H
+
+#include "replication-controller.h"
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Locates the STA distance at which a metric crosses a threshold.
+ *
+ * The objective is a metric, or the ratio of two metrics such as TCP over
+ * QUIC throughput, minus the threshold. Given a bracket [low, high] where the
+ * objective changes sign, every round runs `jobs` distances evenly spread
+ * inside the bracket in parallel and keeps the sub-interval where the sign
+ * changes. Each round therefore narrows the bracket by a factor of jobs + 1,
+ * and the search ends once it is at most `tolerance` meters wide or
+ * `maxRuns` runs are spent. Distances are whole meters, as initPos.
+ */
+class DistanceSearch
+{
+  public:
+    /**
+     * Outcome of a search.
+     */
+    struct Result
+    {
+        int low;         //!< Distance below the crossing.
+        int high;        //!< Distance above the crossing.
+        double crossing; //!< Linear interpolation of the crossing.
+        uint32_t runs;   //!< Runs spent.
+        bool bracketed;  //!< Whether the initial bracket had a sign change.
+    };
+
+    /**
+     * \param program Program path.
+     * \param args Argument template, {distance} and {seed} are replaced.
+     * \param outputDir Root directory of the per-run result directories.
+     * \param jobs Runs per round.
+     */
+    DistanceSearch(std::string program, std::string args, std::string outputDir, uint32_t jobs);
+
+    /**
+     * \param metric The metric.
+     * \param threshold The value whose crossing is searched.
+     */
+    void SetObjective(const ReplicationMetric& metric, double threshold);
+
+    /**
+     * \param numerator The numerator metric.
+     * \param denominator The denominator metric.
+     * \param threshold The ratio whose crossing is searched.
+     */
+    void SetObjective(const ReplicationMetric& numerator,
+                      const ReplicationMetric& denominator,
+                      double threshold);
+
+    /**
+     * Run the search and write search.csv.
+     *
+     * \param low The lower end of the initial bracket (m).
+     * \param high The upper end of the initial bracket (m).
+     * \param tolerance The final bracket width (m).
+     * \param maxRuns The maximum number of runs.
+     * \param seed The run number of every run.
+     * \return The outcome.
+     */
+    Result Run(int low, int high, int tolerance, uint32_t maxRuns, uint32_t seed);
+
+  private:
+    /**
+     * Run the given distances in parallel and record their objective values.
+     *
+     * \param distances The distances.
+     * \param seed The run number.
+     */
+    void Evaluate(const std::vector<int>& distances, uint32_t seed);
+
+    std::string m_program;                    //!< Program path.
+    std::string m_args;                       //!< Argument template.
+    std::string m_outputDir;                  //!< Root result directory.
+    uint32_t m_jobs;                          //!< Runs per round.
+    std::vector<ReplicationMetric> m_metrics; //!< Metric, or numerator and denominator.
+    double m_threshold{1};                    //!< Threshold of the objective.
+    std::map<int, double> m_values;           //!< Objective minus threshold by distance.
+    std::ofstream m_index;                    //!< search.csv.
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_DISTANCE_SEARCH_H */
@@ -0,0 +1,187 @@
+#include "event-profiler.h"
+
+#include "ns3/abort.h"
+#include "ns3/config.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <fstream>
+#include <iomanip>
+#include <typeinfo>
+#include <vector>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ProfilingSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(ProfilingSimulatorImpl);
+
+namespace
+{
+
+std::string
+Demangle(const char* name)
+{
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (status != 0)
+    {
+        return name;
+    }
+    std::string result = demangled;
+    std::free(demangled);
+    return result;
+}
+
+} // namespace
+
+TypeId
+ProfilingSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ProfilingSimulatorImpl")
+            .SetParent<DefaultSimulatorImpl>()
+            .SetGroupName("Fairness")
+            .AddConstructor<ProfilingSimulatorImpl>()
+            .AddAttribute("ReportFile",
+                          "File the per-event-type report is written to on Destroy",
+                          StringValue("event-profile.tsv"),
+                          MakeStringAccessor(&ProfilingSimulatorImpl::m_reportFile),
+                          MakeStringChecker());
+    return tid;
+}
+
+ProfilingSimulatorImpl::ProfilingSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ProfilingSimulatorImpl::~ProfilingSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ProfilingSimulatorImpl::ProfiledEvent::ProfiledEvent(EventStats& stats, EventImpl* event)
+    : m_stats(stats),
+      m_event(event, false)
+{
+}
+
+void
+ProfilingSimulatorImpl::ProfiledEvent::Notify()
+{
+    const auto start = std::chrono::steady_clock::now();
+    m_event->Invoke();
+    m_stats.wall += std::chrono::steady_clock::now() - start;
+    m_stats.count++;
+}
+
+EventImpl*
+ProfilingSimulatorImpl::Wrap(EventImpl* event)
+{
+    return new ProfiledEvent(m_stats[std::type_index(typeid(*event))], event);
+}
+
+EventId
+ProfilingSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    return DefaultSimulatorImpl::Schedule(delay, Wrap(event));
+}
+
+void
+ProfilingSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event)
+{
+    DefaultSimulatorImpl::ScheduleWithContext(context, delay, Wrap(event));
+}
+
+EventId
+ProfilingSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return DefaultSimulatorImpl::ScheduleNow(Wrap(event));
+}
+
+EventId
+ProfilingSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    return DefaultSimulatorImpl::ScheduleDestroy(Wrap(event));
+}
+
+void
+ProfilingSimulatorImpl::Run()
+{
+    const auto start = std::chrono::steady_clock::now();
+    DefaultSimulatorImpl::Run();
+    m_runWall += std::chrono::steady_clock::now() - start;
+}
+
+void
+ProfilingSimulatorImpl::Destroy()
+{
+    // The destroy events are profiled too, so report once they have run
+    DefaultSimulatorImpl::Destroy();
+    WriteReport();
+}
+
+void
+ProfilingSimulatorImpl::WriteReport() const
+{
+    std::vector<std::pair<std::string, EventStats>> rows;
+    uint64_t totalCount = 0;
+    std::chrono::nanoseconds totalWall{0};
+    for (const auto& [type, stats] : m_stats)
+    {
+        if (stats.count > 0)
+        {
+            rows.emplace_back(Demangle(type.name()), stats);
+            totalCount += stats.count;
+            totalWall += stats.wall;
+        }
+    }
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        return a.second.wall > b.second.wall;
+    });
+
+    std::ofstream report(m_reportFile);
+    NS_ABORT_MSG_UNLESS(report.is_open(), "Cannot open profile report " << m_reportFile);
+    const double runSeconds = std::chrono::duration<double>(m_runWall).count();
+    report << "# run wall time " << runSeconds << " s, " << totalCount << " events, "
+           << runSeconds - std::chrono::duration<double>(totalWall).count()
+           << " s outside the events\n";
+    report << "wall_s\tshare\tevents\tns_per_event\tevent\n";
+    report << std::fixed;
+    for (const auto& [name, stats] : rows)
+    {
+        const double wall = std::chrono::duration<double>(stats.wall).count();
+        report << std::setprecision(6) << wall << "\t" << std::setprecision(4)
+               << (totalWall.count() > 0 ? double(stats.wall.count()) / totalWall.count() : 0.0)
+               << "\t" << stats.count << "\t" << std::setprecision(0)
+               << double(stats.wall.count()) / stats.count << "\t" << name << "\n";
+    }
+    NS_LOG_INFO("Event profile of " << totalCount << " events written to " << m_reportFile);
+}
+
+void
+EnableEventProfiler(const std::string& reportFile)
+{
+    Config::SetDefault("ns3::ProfilingSimulatorImpl::ReportFile", StringValue(reportFile));
+    GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::ProfilingSimulatorImpl"));
+}
+
+void
+SetEventProfilerReport(const std::string& reportFile)
+{
+    Ptr<ProfilingSimulatorImpl> profiler =
+        DynamicCast<ProfilingSimulatorImpl>(Simulator::GetImplementation());
+    if (profiler)
+    {
+        profiler->SetAttribute("ReportFile", StringValue(reportFile));
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,113 @@
+#ifndef FAIRNESS_EVENT_PROFILER_H
+#define FAIRNESS_EVENT_PROFILER_H
+
+#include "ns3/default-simulator-impl.h"
+#include "ns3/event-impl.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+namespace ns3
+{
+
+/**
+ * Default simulator that records, per event type, how many events ran and
+ * the wall time spent in them.
+ *
+ * Every scheduled event is wrapped, so the type of the wrapped EventImpl
+ * identifies the callback target: the class and signature of a member
+ * function event (e.g. WifiPhy or QuicSocketBase timers) or the signature of
+ * a function event. On Destroy, a report sorted by wall time is written to
+ * the ReportFile attribute, tab separated, together with the time spent in
+ * the scheduler itself.
+ *
+ * Select it with EnableEventProfiler() before the first simulator call.
+ */
+class ProfilingSimulatorImpl : public DefaultSimulatorImpl
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    ProfilingSimulatorImpl();
+    ~ProfilingSimulatorImpl() override;
+
+    // Inherited from DefaultSimulatorImpl
+    void Destroy() override;
+    void Run() override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+
+  private:
+    /**
+     * Counters of one event type.
+     */
+    struct EventStats
+    {
+        uint64_t count{0};                //!< Events executed.
+        std::chrono::nanoseconds wall{0}; //!< Wall time spent in them.
+    };
+
+    /**
+     * Event that times the event it wraps.
+     */
+    class ProfiledEvent : public EventImpl
+    {
+      public:
+        /**
+         * \param stats The counters to add to.
+         * \param event The event to run, owned from now on.
+         */
+        ProfiledEvent(EventStats& stats, EventImpl* event);
+
+      private:
+        void Notify() override;
+
+        EventStats& m_stats;    //!< Counters of the event type.
+        Ptr<EventImpl> m_event; //!< The wrapped event.
+    };
+
+    /**
+     * \param event An event to schedule.
+     * \return The timing wrapper of the event.
+     */
+    EventImpl* Wrap(EventImpl* event);
+
+    /**
+     * Write the report to m_reportFile.
+     */
+    void WriteReport() const;
+
+    std::string m_reportFile;                                //!< Report file name.
+    std::unordered_map<std::type_index, EventStats> m_stats; //!< Counters by event type.
+    std::chrono::nanoseconds m_runWall{0};                   //!< Wall time of Run.
+};
+
+/**
+ * Make the next simulator a ProfilingSimulatorImpl. Must be called before
+ * anything is scheduled.
+ *
+ * \param reportFile The file the report is written to on Simulator::Destroy.
+ */
+void EnableEventProfiler(const std::string& reportFile);
+
+/**
+ * Point the running ProfilingSimulatorImpl, if any, at another report file,
+ * e.g. in a process forked from the one that enabled it. The counters are
+ * kept, so the report still covers the events run before the change.
+ *
+ * \param reportFile The file the report is written to on Simulator::Destroy.
+ */
+void SetEventProfilerReport(const std::string& reportFile);
+
+} // namespace ns3
+
+#endif /* FAIRNESS_EVENT_PROFILER_H */
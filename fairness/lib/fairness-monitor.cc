@@ -0,0 +1,105 @@
+#include "fairness-monitor.h"
+
+#include "steady-state-monitor.h"
+
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+
+FairnessMonitor::FairnessMonitor(const std::string& fileName,
+                                 const std::vector<std::string>& protocols)
+    : m_protocols(protocols),
+      m_file(fileName)
+{
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "Cannot open " << fileName);
+    m_file << "time,flows,total_kbps,jain,max_min_ratio";
+    for (const auto& protocol : m_protocols)
+    {
+        m_file << "," << protocol << "_share";
+        m_shares[protocol] = 0;
+    }
+    m_file << "\n";
+}
+
+void
+FairnessMonitor::Record(const std::string& protocol, const std::string& flow, double kbps)
+{
+    NS_ABORT_MSG_UNLESS(m_shares.count(protocol), "Unknown protocol " << protocol);
+    if (!m_pending)
+    {
+        // Runs after the statistics of every flow for this step, as in
+        // SteadyStateMonitor
+        m_pending = true;
+        Simulator::ScheduleNow(&FairnessMonitor::EndStep, this);
+    }
+    m_current[protocol][flow] = kbps;
+}
+
+void
+FairnessMonitor::EndStep()
+{
+    m_pending = false;
+    std::vector<double> values;
+    std::map<std::string, double> protocolKbps;
+    double total = 0;
+    for (const auto& [protocol, flows] : m_current)
+    {
+        // Starved flows count, as in SteadyStateMonitor and TraceSummarizer
+        for (const auto& [flow, kbps] : flows)
+        {
+            values.push_back(kbps);
+            protocolKbps[protocol] += kbps;
+            total += kbps;
+        }
+    }
+    m_current.clear();
+
+    m_jain = ns3::GetJainIndex(values);
+    m_maxMinRatio = 1;
+    if (values.size() > 1)
+    {
+        const auto [min, max] = std::minmax_element(values.begin(), values.end());
+        if (*min > 0)
+        {
+            m_maxMinRatio = *max / *min;
+        }
+        else if (*max > 0)
+        {
+            m_maxMinRatio = std::numeric_limits<double>::infinity();
+        }
+    }
+    m_file << Simulator::Now().GetSeconds() << "," << values.size() << "," << total << ","
+           << m_jain << "," << m_maxMinRatio;
+    for (const auto& protocol : m_protocols)
+    {
+        m_shares[protocol] = total > 0 ? protocolKbps[protocol] / total : 0;
+        m_file << "," << m_shares[protocol];
+    }
+    m_file << "\n";
+}
+
+double
+FairnessMonitor::GetJainIndex() const
+{
+    return m_jain;
+}
+
+double
+FairnessMonitor::GetMaxMinRatio() const
+{
+    return m_maxMinRatio;
+}
+
+double
+FairnessMonitor::GetShare(const std::string& protocol) const
+{
+    auto it = m_shares.find(protocol);
+    return it == m_shares.end() ? 0 : it->second;
+}
+
+} // namespace ns3
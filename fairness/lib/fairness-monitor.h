@@ -0,0 +1,77 @@
+#ifndef FAIRNESS_FAIRNESS_MONITOR_H
+#define FAIRNESS_FAIRNESS_MONITOR_H
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Per-step fairness series over all the flows of a run.
+ *
+ * The per-step statistics Record() the throughput of each flow with its
+ * protocol. After all records of a step, the monitor takes every recorded
+ * flow, including those that got nothing, and writes one row to its CSV
+ * file: the time, the number of flows, their total throughput, Jain's
+ * fairness index, the ratio of the largest to the smallest throughput and the
+ * share of the total throughput of every protocol. Jain's index is that of
+ * GetJainIndex(), as in SteadyStateMonitor and TraceSummarizer. The figures
+ * of the last step are also available to other in-simulation logic.
+ */
+class FairnessMonitor
+{
+  public:
+    /**
+     * \param fileName The CSV file to write.
+     * \param protocols The protocols, one share column each.
+     */
+    FairnessMonitor(const std::string& fileName, const std::vector<std::string>& protocols);
+
+    /**
+     * Record the throughput of a flow in the current step.
+     *
+     * \param protocol The protocol of the flow, one of the constructor's.
+     * \param flow The flow name.
+     * \param kbps The throughput over the step.
+     */
+    void Record(const std::string& protocol, const std::string& flow, double kbps);
+
+    /**
+     * \return Jain's fairness index of the last step.
+     */
+    double GetJainIndex() const;
+
+    /**
+     * \return The largest over the smallest throughput of the last step,
+     * infinite if a flow got nothing while another did, 1 if fewer than two
+     * flows were recorded or none got anything.
+     */
+    double GetMaxMinRatio() const;
+
+    /**
+     * \param protocol A protocol.
+     * \return Its share of the total throughput of the last step.
+     */
+    double GetShare(const std::string& protocol) const;
+
+  private:
+    /**
+     * Close the current step and write its row.
+     */
+    void EndStep();
+
+    std::vector<std::string> m_protocols;                           //!< Protocols.
+    std::ofstream m_file;                                           //!< The fairness series.
+    std::map<std::string, std::map<std::string, double>> m_current; //!< kbps by protocol and flow.
+    bool m_pending{false};                                          //!< Whether EndStep is pending.
+    double m_jain{1};                                               //!< Last Jain's index.
+    double m_maxMinRatio{1};                                        //!< Last max-min ratio.
+    std::map<std::string, double> m_shares;                         //!< Last share by protocol.
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_FAIRNESS_MONITOR_H */
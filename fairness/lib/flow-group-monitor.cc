@@ -0,0 +1,82 @@
+#include "flow-group-monitor.h"
+
+#include "ns3/simulator.h"
+
+namespace ns3
+{
+
+FlowGroupMonitor::FlowGroupMonitor(NodeContainer nodes)
+    : m_monitor(m_helper.Install(nodes)),
+      m_classifier(DynamicCast<Ipv4FlowClassifier>(m_helper.GetClassifier())),
+      m_sampler(m_monitor)
+{
+}
+
+uint32_t
+FlowGroupMonitor::AddGroup(Ipv4Address server)
+{
+    m_servers.push_back(server);
+    m_intervals.emplace_back();
+    return m_servers.size() - 1;
+}
+
+const FlowGroupMonitor::FlowClass&
+FlowGroupMonitor::Classify(FlowId flowId)
+{
+    auto it = m_classes.find(flowId);
+    if (it != m_classes.end())
+    {
+        return it->second;
+    }
+    FlowClass flowClass{NO_GROUP, m_classifier->FindFlow(flowId)};
+    for (uint32_t i = 0; i < m_servers.size(); i++)
+    {
+        if (flowClass.tuple.destinationAddress == m_servers[i] ||
+            flowClass.tuple.sourceAddress == m_servers[i])
+        {
+            flowClass.group = i;
+            break;
+        }
+    }
+    return m_classes.emplace(flowId, flowClass).first->second;
+}
+
+const std::vector<FlowGroupMonitor::Flow>&
+FlowGroupMonitor::GetIntervals(uint32_t group)
+{
+    if (!m_sampled || m_sampleTime != Simulator::Now())
+    {
+        m_sampled = true;
+        m_sampleTime = Simulator::Now();
+        for (std::vector<Flow>& flows : m_intervals)
+        {
+            flows.clear();
+        }
+        for (const auto& [flowId, interval] : m_sampler.Sample())
+        {
+            const FlowClass& flowClass = Classify(flowId);
+            if (flowClass.group != NO_GROUP)
+            {
+                m_intervals[flowClass.group].push_back({flowId, flowClass.tuple, interval});
+            }
+        }
+    }
+    return m_intervals.at(group);
+}
+
+std::vector<FlowGroupMonitor::Flow>
+FlowGroupMonitor::GetTotals(uint32_t group)
+{
+    std::vector<Flow> flows;
+    for (const auto& [flowId, total] : m_sampler.GetTotals())
+    {
+        const FlowClass& flowClass = Classify(flowId);
+        if (flowClass.group == group)
+        {
+            flows.push_back({flowId, flowClass.tuple, total});
+        }
+    }
+    return flows;
+}
+
+} // namespace ns3
@@ -0,0 +1,101 @@
+#ifndef FAIRNESS_FLOW_GROUP_MONITOR_H
+#define FAIRNESS_FLOW_GROUP_MONITOR_H
+
+#include "interval-flow-sampler.h"
+
+#include "ns3/flow-monitor-helper.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/node-container.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * One FlowMonitor over the whole topology, with the flows split into groups
+ * by server.
+ *
+ * A flow belongs to the group of the server at either of its ends, so a group
+ * holds both the data flows to its server and the ACK or reverse flows from
+ * it. Flows that touch no group server are ignored. Each flow is looked up in
+ * the classifier once, on its first sample.
+ */
+class FlowGroupMonitor
+{
+  public:
+    /**
+     * A flow of a group with its metrics.
+     */
+    struct Flow
+    {
+        FlowId flowId;                       //!< Monitor flow id.
+        Ipv4FlowClassifier::FiveTuple tuple; //!< Flow addresses and ports.
+        FlowInterval metrics;                //!< Interval or total metrics.
+    };
+
+    /**
+     * \param nodes The nodes to install the monitor on.
+     */
+    FlowGroupMonitor(NodeContainer nodes);
+
+    /**
+     * \param server The server address of the group.
+     * \return The group index.
+     */
+    uint32_t AddGroup(Ipv4Address server);
+
+    /**
+     * Metrics of a group since the previous sample.
+     *
+     * The monitor is sampled at most once per simulation time, so the groups
+     * can be read one after the other in the same step and still cover the
+     * same interval.
+     *
+     * \param group The group index.
+     * \return The flows of the group.
+     */
+    const std::vector<Flow>& GetIntervals(uint32_t group);
+
+    /**
+     * \param group The group index.
+     * \return The flows of the group with their whole-run metrics.
+     */
+    std::vector<Flow> GetTotals(uint32_t group);
+
+  private:
+    /// Group of flows outside every group.
+    static constexpr uint32_t NO_GROUP = UINT32_MAX;
+
+    /**
+     * Classification of a flow.
+     */
+    struct FlowClass
+    {
+        uint32_t group;                      //!< Group index, or NO_GROUP.
+        Ipv4FlowClassifier::FiveTuple tuple; //!< Flow addresses and ports.
+    };
+
+    /**
+     * \param flowId A flow.
+     * \return The classification of the flow.
+     */
+    const FlowClass& Classify(FlowId flowId);
+
+    FlowMonitorHelper m_helper;                      //!< Owns the monitor and classifier.
+    Ptr<FlowMonitor> m_monitor;                      //!< The monitor.
+    Ptr<Ipv4FlowClassifier> m_classifier;            //!< The IPv4 classifier.
+    IntervalFlowSampler m_sampler;                   //!< Interval sampler.
+    std::vector<Ipv4Address> m_servers;              //!< Server of each group.
+    std::unordered_map<FlowId, FlowClass> m_classes; //!< Classified flows.
+    std::vector<std::vector<Flow>> m_intervals;      //!< Last sample by group.
+    Time m_sampleTime;                               //!< Time of the last sample.
+    bool m_sampled{false};                           //!< Whether a sample was taken.
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_FLOW_GROUP_MONITOR_H */
@@ -0,0 +1,202 @@
+#include "interval-flow-sampler.h"
+
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+
+namespace ns3
+{
+
+namespace
+{
+
+/**
+ * \param histogram A FlowMonitor histogram, copied as its bin accessors are
+ * not const.
+ * \return The count of every bin, none before the first received packet.
+ */
+std::vector<uint32_t>
+GetBins(Histogram histogram)
+{
+    std::vector<uint32_t> bins(histogram.GetNBins());
+    for (uint32_t i = 0; i < bins.size(); i++)
+    {
+        bins[i] = histogram.GetBinCount(i);
+    }
+    return bins;
+}
+
+/**
+ * \param current Cumulative bin counts.
+ * \param last Cumulative bin counts at the previous sample.
+ * \return The counts added since.
+ */
+std::vector<uint32_t>
+DiffBins(const std::vector<uint32_t>& current, const std::vector<uint32_t>& last)
+{
+    std::vector<uint32_t> bins(current);
+    for (std::size_t i = 0; i < std::min(bins.size(), last.size()); i++)
+    {
+        bins[i] -= last[i];
+    }
+    return bins;
+}
+
+/**
+ * \param bins Bin counts of a histogram starting at zero.
+ * \param binWidth The bin width (s).
+ * \param percent The percentile, in [0, 100].
+ * \return The percentile, interpolated linearly within its bin.
+ */
+Time
+GetPercentile(const std::vector<uint32_t>& bins, double binWidth, double percent)
+{
+    const uint64_t total = std::accumulate(bins.begin(), bins.end(), uint64_t(0));
+    if (total == 0)
+    {
+        return Time();
+    }
+    const double rank = percent / 100 * total;
+    uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < bins.size(); i++)
+    {
+        if (bins[i] > 0 && cumulative + bins[i] >= rank)
+        {
+            return Seconds((i + (rank - cumulative) / bins[i]) * binWidth);
+        }
+        cumulative += bins[i];
+    }
+    return Seconds(bins.size() * binWidth);
+}
+
+} // namespace
+
+double
+FlowInterval::GetKbps() const
+{
+    if (!duration.IsStrictlyPositive())
+    {
+        return 0;
+    }
+    return rxBytes * 8.0 / duration.GetSeconds() / 1024;
+}
+
+double
+FlowInterval::GetLossPercent() const
+{
+    return std::abs((int64_t)txPackets - (int64_t)rxPackets) * 100 / (txPackets + 0.01);
+}
+
+double
+FlowInterval::GetDeliveryPercent() const
+{
+    return rxPackets * 100 / (txPackets + 0.01);
+}
+
+Time
+FlowInterval::GetMeanDelay() const
+{
+    return rxPackets ? delaySum / rxPackets : Time();
+}
+
+Time
+FlowInterval::GetMeanJitter() const
+{
+    return rxPackets > 1 ? jitterSum / (rxPackets - 1) : Time();
+}
+
+Time
+FlowInterval::GetDelayPercentile(double percent) const
+{
+    return GetPercentile(delayBins, delayBinWidth, percent);
+}
+
+Time
+FlowInterval::GetJitterPercentile(double percent) const
+{
+    return GetPercentile(jitterBins, jitterBinWidth, percent);
+}
+
+IntervalFlowSampler::IntervalFlowSampler(Ptr<FlowMonitor> monitor)
+    : m_monitor(monitor),
+      m_lastTime(Simulator::Now())
+{
+    // An empty histogram has no bin to read the width from
+    DoubleValue width;
+    m_monitor->GetAttribute("DelayBinWidth", width);
+    m_delayBinWidth = width.Get();
+    m_monitor->GetAttribute("JitterBinWidth", width);
+    m_jitterBinWidth = width.Get();
+}
+
+const IntervalFlowSampler::IntervalContainer&
+IntervalFlowSampler::Sample()
+{
+    const Time now = Simulator::Now();
+    const Time duration = now - m_lastTime;
+    m_lastTime = now;
+
+    for (const auto& [flowId, stats] : m_monitor->GetFlowStats())
+    {
+        FlowInterval current = GetCounters(stats);
+        FlowInterval& last = m_last[flowId];
+        FlowInterval& interval = m_intervals[flowId];
+        interval.duration = duration;
+        interval.txBytes = current.txBytes - last.txBytes;
+        interval.rxBytes = current.rxBytes - last.rxBytes;
+        interval.txPackets = current.txPackets - last.txPackets;
+        interval.rxPackets = current.rxPackets - last.rxPackets;
+        interval.lostPackets = current.lostPackets - last.lostPackets;
+        interval.delaySum = current.delaySum - last.delaySum;
+        interval.jitterSum = current.jitterSum - last.jitterSum;
+        interval.lastDelay = current.lastDelay;
+        interval.delayBinWidth = current.delayBinWidth;
+        interval.delayBins = DiffBins(current.delayBins, last.delayBins);
+        interval.jitterBinWidth = current.jitterBinWidth;
+        interval.jitterBins = DiffBins(current.jitterBins, last.jitterBins);
+        last = std::move(current);
+    }
+    return m_intervals;
+}
+
+IntervalFlowSampler::IntervalContainer
+IntervalFlowSampler::GetTotals() const
+{
+    IntervalContainer totals;
+    for (const auto& [flowId, stats] : m_monitor->GetFlowStats())
+    {
+        FlowInterval& total = totals[flowId] = GetCounters(stats);
+        total.duration = stats.timeLastRxPacket - stats.timeFirstTxPacket;
+    }
+    return totals;
+}
+
+FlowInterval
+IntervalFlowSampler::GetCounters(const FlowMonitor::FlowStats& stats) const
+{
+    FlowInterval counters;
+    counters.txBytes = stats.txBytes;
+    counters.rxBytes = stats.rxBytes;
+    counters.txPackets = stats.txPackets;
+    counters.rxPackets = stats.rxPackets;
+    counters.lostPackets = stats.lostPackets;
+    counters.delaySum = stats.delaySum;
+    counters.jitterSum = stats.jitterSum;
+    counters.lastDelay = stats.lastDelay;
+    counters.delayBinWidth = m_delayBinWidth;
+    counters.delayBins = GetBins(stats.delayHistogram);
+    counters.jitterBinWidth = m_jitterBinWidth;
+    counters.jitterBins = GetBins(stats.jitterHistogram);
+    return counters;
+}
+
+Ptr<FlowMonitor>
+IntervalFlowSampler::GetMonitor() const
+{
+    return m_monitor;
+}
+
+} // namespace ns3
@@ -0,0 +1,130 @@
+#ifndef FAIRNESS_INTERVAL_FLOW_SAMPLER_H
+#define FAIRNESS_INTERVAL_FLOW_SAMPLER_H
+
+#include "ns3/flow-monitor.h"
+#include "ns3/nstime.h"
+
+#include <map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Flow metrics over a time span.
+ */
+struct FlowInterval
+{
+    Time duration;                    //!< Length of the span.
+    uint64_t txBytes{0};              //!< Bytes sent.
+    uint64_t rxBytes{0};              //!< Bytes received.
+    uint32_t txPackets{0};            //!< Packets sent.
+    uint32_t rxPackets{0};            //!< Packets received.
+    uint32_t lostPackets{0};          //!< Packets declared lost by the monitor.
+    Time delaySum;                    //!< Sum of the end-to-end delays of the received packets.
+    Time jitterSum;                   //!< Sum of the delay variations of the received packets.
+    Time lastDelay;                   //!< Delay of the last received packet.
+    double delayBinWidth{0};          //!< Delay histogram bin width (s).
+    std::vector<uint32_t> delayBins;  //!< Received packets per delay bin.
+    double jitterBinWidth{0};         //!< Jitter histogram bin width (s).
+    std::vector<uint32_t> jitterBins; //!< Received packets per jitter bin.
+
+    /**
+     * \return The receive rate in kbit/s (1 kbit = 1024 bit, as in the legacy CSVs).
+     */
+    double GetKbps() const;
+
+    /**
+     * \return Sent minus received packets, in percent of the sent packets.
+     */
+    double GetLossPercent() const;
+
+    /**
+     * \return Received packets in percent of the sent packets.
+     */
+    double GetDeliveryPercent() const;
+
+    /**
+     * \return The mean delay of the received packets.
+     */
+    Time GetMeanDelay() const;
+
+    /**
+     * \return The mean jitter of the received packets.
+     */
+    Time GetMeanJitter() const;
+
+    /**
+     * \param percent The percentile, in [0, 100].
+     * \return The delay percentile of the received packets, interpolated
+     * within the FlowMonitor delay histogram bin (see its DelayBinWidth
+     * attribute), zero if none were received.
+     */
+    Time GetDelayPercentile(double percent) const;
+
+    /**
+     * \param percent The percentile, in [0, 100].
+     * \return The jitter percentile of the received packets, interpolated
+     * within the FlowMonitor jitter histogram bin (see its JitterBinWidth
+     * attribute), zero if none were received.
+     */
+    Time GetJitterPercentile(double percent) const;
+};
+
+/**
+ * Per-interval view of the cumulative FlowMonitor statistics.
+ *
+ * Every Sample() diffs the flow counters and the delay and jitter histograms
+ * against the previous sample, so the monitor never has to be reset and the
+ * cumulative statistics stay available for the end-of-run totals. The
+ * per-interval percentiles thus cost one histogram per flow, not one sample
+ * per packet.
+ */
+class IntervalFlowSampler
+{
+  public:
+    /// Interval metrics by flow.
+    typedef std::map<FlowId, FlowInterval> IntervalContainer;
+
+    /**
+     * \param monitor The monitor to sample.
+     */
+    IntervalFlowSampler(Ptr<FlowMonitor> monitor);
+
+    /**
+     * Diff the flow counters against the previous sample, or against the
+     * creation of the sampler for the first one.
+     *
+     * \return The metrics of every flow seen so far over the elapsed interval.
+     */
+    const IntervalContainer& Sample();
+
+    /**
+     * \return The cumulative metrics of every flow, each over its own
+     * lifetime from the first sent to the last received packet.
+     */
+    IntervalContainer GetTotals() const;
+
+    /**
+     * \return The sampled monitor.
+     */
+    Ptr<FlowMonitor> GetMonitor() const;
+
+  private:
+    /**
+     * \param stats Cumulative flow statistics.
+     * \return The counters and histogram bins of the statistics.
+     */
+    FlowInterval GetCounters(const FlowMonitor::FlowStats& stats) const;
+
+    Ptr<FlowMonitor> m_monitor;    //!< Sampled monitor.
+    double m_delayBinWidth;        //!< DelayBinWidth of the monitor (s).
+    double m_jitterBinWidth;       //!< JitterBinWidth of the monitor (s).
+    IntervalContainer m_last;      //!< Cumulative counters at the previous sample.
+    Time m_lastTime;               //!< Time of the previous sample.
+    IntervalContainer m_intervals; //!< Result of the last sample.
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_INTERVAL_FLOW_SAMPLER_H */
@@ -0,0 +1,157 @@
+#include "node-statistics.h"
+
+#include "ns3/flow-monitor-module.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <filesystem>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NodeStatistics");
+
+NodeStatistics::NodeStatistics(NodeContainer nodes, std::string flowName, bool isDoubleStream): fh(), monitor(fh.Install(nodes)), sampler(monitor), asciiHelper(){
+    this->isDoubleStream = isDoubleStream;
+    this->nodes = nodes;
+
+    this->flowName = flowName;
+    std::ostringstream client; client << flowName << "-client.csv";
+    clientMetrics = asciiHelper.CreateFileStream(client.str().c_str());
+    *clientMetrics->GetStream() << "dist,kbps,jitter_mils,plr,pdr,delay_mils,pkt_sent,pkt_rcv,pkt_loss,signal,noise,source,dest,delay_p50_mils,delay_p90_mils,delay_p99_mils,jitter_p50_mils,jitter_p90_mils,jitter_p99_mils" << std::endl;
+    std::ostringstream server; server << flowName << "-server.csv";
+    serverMetrics = asciiHelper.CreateFileStream(server.str().c_str());
+    *serverMetrics->GetStream() << "dist,kbps,jitter_mils,plr,pdr,delay_mils,pkt_sent,pkt_rcv,pkt_loss,signal,noise,source,dest,delay_p50_mils,delay_p90_mils,delay_p99_mils,jitter_p50_mils,jitter_p90_mils,jitter_p99_mils" << std::endl;
+}
+
+void NodeStatistics::SetPosition(Ptr<Node> node, Vector position){
+    Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+    mobility->SetPosition(position);
+}
+
+Vector NodeStatistics::GetPosition(Ptr<Node> node){
+    Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+    return mobility->GetPosition();
+}
+
+void NodeStatistics::MonitorSnifferRxCallback(std::string context, Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector, MpduInfo aMpdu, SignalNoiseDbm sigNoi, uint16_t staId){
+    this->signalNoise = sigNoi;
+}
+
+void NodeStatistics::AdvancePosition(Ptr<Node> node, int stepsSize, int stepsTime){
+    NS_LOG_INFO("### ADVANCING: STEP " << stepItr << "; STA NODE_NAME: " << this->flowName << " ###");
+    stepItr++;
+    Vector pos = GetPosition(node);
+    Metrics();
+    pos.x += stepsSize;
+    SetPosition(node, pos);
+    Simulator::Schedule(Seconds(stepsTime),
+                        &NodeStatistics::AdvancePosition,
+                        this,
+                        node,
+                        stepsSize,
+                        stepsTime);
+}
+
+void NodeStatistics::Metrics(){
+    int i = 0;
+    Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier> (fh.GetClassifier());
+    for (const auto& [flowId, interval] : sampler.Sample()){
+        Ipv4FlowClassifier::FiveTuple tuple = classifier->FindFlow(flowId);
+        NS_LOG_UNCOND(" " << stepItr << "|kbps:"
+                          << interval.GetKbps() << "|jitter_mils:"
+                          << interval.jitterSum.GetMilliSeconds() << "|plr:" //jitter_mils
+                          << interval.GetLossPercent() << "|pdr:" //packet loss ratio
+                          << interval.GetDeliveryPercent() << "|delay_mils:" //packet delivery ratio
+                          << interval.lastDelay.GetMilliSeconds() << "|pkt_sent:" //delay_mils
+                          << interval.txPackets << "|pkt_rcv:" //packet sent
+                          << interval.rxPackets << "|pkt_loss:" //packet receive
+                          << std::abs((int)interval.txPackets - (int)interval.rxPackets) << "|signal:" // packet loss
+                          << tuple.sourceAddress  << "|dest:" //source
+                          << tuple.destinationAddress ); //dest
+
+        if(i==0){
+            WriteMetrics(clientMetrics, interval, tuple);
+            if(steadyState != nullptr){
+                steadyState->Record(flowName, interval.GetKbps());
+            }
+            if(fairness != nullptr){
+                fairness->Record(protocol, flowName, interval.GetKbps());
+            }
+            if(isDoubleStream == false)break;
+        }
+        else{
+            WriteMetrics(serverMetrics, interval, tuple);
+            break;
+        }
+        i++;
+    }
+}
+
+void NodeStatistics::WriteMetrics(Ptr<OutputStreamWrapper> stream, const FlowInterval& interval, const Ipv4FlowClassifier::FiveTuple& tuple){
+    *stream->GetStream() << stepItr << ","
+                         << interval.GetKbps() << ","
+                         << interval.jitterSum.GetMilliSeconds() << ","
+                         << interval.GetLossPercent() << ","
+                         << interval.GetDeliveryPercent() << ","
+                         << interval.lastDelay.GetMilliSeconds() << ","
+                         << interval.txPackets << ","
+                         << interval.rxPackets << ","
+                         << std::abs((int)interval.txPackets - (int)interval.rxPackets) << ","
+                         << this->signalNoise.signal << ","
+                         << this->signalNoise.noise << ","
+                         << tuple.sourceAddress  << ","
+                         << tuple.destinationAddress << ","
+                         << interval.GetDelayPercentile(50).GetSeconds() * 1000 << ","
+                         << interval.GetDelayPercentile(90).GetSeconds() * 1000 << ","
+                         << interval.GetDelayPercentile(99).GetSeconds() * 1000 << ","
+                         << interval.GetJitterPercentile(50).GetSeconds() * 1000 << ","
+                         << interval.GetJitterPercentile(90).GetSeconds() * 1000 << ","
+                         << interval.GetJitterPercentile(99).GetSeconds() * 1000 << std::endl;
+    if(database != nullptr){
+        std::ostringstream source; source << tuple.sourceAddress;
+        std::ostringstream dest; dest << tuple.destinationAddress;
+        database->Insert({protocol,
+                          std::filesystem::path(flowName).filename().string(),
+                          stream == clientMetrics ? "client" : "server",
+                          stepItr,
+                          interval.GetKbps(),
+                          double(interval.jitterSum.GetMilliSeconds()),
+                          interval.GetLossPercent(),
+                          double(interval.lastDelay.GetMilliSeconds()),
+                          interval.txPackets,
+                          interval.rxPackets,
+                          this->signalNoise.signal,
+                          this->signalNoise.noise,
+                          source.str(),
+                          dest.str(),
+                          interval.GetDelayPercentile(50).GetSeconds() * 1000,
+                          interval.GetDelayPercentile(90).GetSeconds() * 1000,
+                          interval.GetDelayPercentile(99).GetSeconds() * 1000,
+                          interval.GetJitterPercentile(50).GetSeconds() * 1000,
+                          interval.GetJitterPercentile(90).GetSeconds() * 1000,
+                          interval.GetJitterPercentile(99).GetSeconds() * 1000});
+    }
+}
+
+void NodeStatistics::WriteTotals(){
+    std::ostringstream totals; totals << flowName << "-totals.csv";
+    Ptr<OutputStreamWrapper> totalsCsv = asciiHelper.CreateFileStream(totals.str().c_str());
+    *totalsCsv->GetStream() << "kbps,delay_mean_mils,jitter_mean_mils,plr,pdr,pkt_sent,pkt_rcv,pkt_loss,source,dest" << std::endl;
+    Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier> (fh.GetClassifier());
+    for (const auto& [flowId, total] : sampler.GetTotals()){
+        Ipv4FlowClassifier::FiveTuple tuple = classifier->FindFlow(flowId);
+        *totalsCsv->GetStream() << total.GetKbps() << ","
+                                << total.GetMeanDelay().GetMilliSeconds() << ","
+                                << total.GetMeanJitter().GetMilliSeconds() << ","
+                                << total.GetLossPercent() << ","
+                                << total.GetDeliveryPercent() << ","
+                                << total.txPackets << ","
+                                << total.rxPackets << ","
+                                << std::abs((int)total.txPackets - (int)total.rxPackets) << ","
+                                << tuple.sourceAddress << ","
+                                << tuple.destinationAddress << std::endl;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,69 @@
+#ifndef FAIRNESS_NODE_STATISTICS_H
+#define FAIRNESS_NODE_STATISTICS_H
+
+#include "fairness-monitor.h"
+#include "interval-flow-sampler.h"
+#include "results-database.h"
+#include "steady-state-monitor.h"
+
+#include "ns3/flow-monitor-helper.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/mobility-model.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * Per-STA statistics of the fairness scenario.
+ *
+ * Samples the flows between one STA and its server every step, writes them to
+ * <flowName>-client.csv (and <flowName>-server.csv for the reverse flow) and
+ * moves the STA by the step size. The per-step values cover the last step
+ * only, including the delay and jitter percentiles taken from the FlowMonitor
+ * histograms; WriteTotals() adds the whole-run figures in <flowName>-totals.csv.
+ * With a steadyState or fairness monitor set, the client throughput of every
+ * step is also handed to it, and with a database set, every per-step row is
+ * also inserted there under the given protocol.
+ */
+class NodeStatistics
+{
+  public:
+    bool isDoubleStream;
+    std::string flowName;
+    int stepItr = 0;
+    FlowMonitorHelper fh;
+    Ptr<FlowMonitor> monitor;
+    IntervalFlowSampler sampler;
+    AsciiTraceHelper asciiHelper;
+    NodeContainer nodes;
+    Ptr<OutputStreamWrapper> serverMetrics;
+    Ptr<OutputStreamWrapper> clientMetrics;
+    SignalNoiseDbm signalNoise;
+    SteadyStateMonitor* steadyState = nullptr;
+    FairnessMonitor* fairness = nullptr;
+    ResultsDatabase* database = nullptr;
+    std::string protocol;
+
+    NodeStatistics(NodeContainer nodes, std::string flowName, bool isDoubleStream);
+    void SetPosition(Ptr<Node> node, Vector position);
+    void AdvancePosition(Ptr<Node> node, int stepsSize, int stepsTime);
+    Vector GetPosition(Ptr<Node> node);
+    void Metrics();
+    void WriteMetrics(Ptr<OutputStreamWrapper> stream, const FlowInterval& interval, const Ipv4FlowClassifier::FiveTuple& tuple);
+    void WriteTotals();
+    void MonitorSnifferRxCallback(std::string context,
+                                  Ptr<const Packet> packet,
+                                  uint16_t channelFreqMhz,
+                                  WifiTxVector txVector,
+                                  MpduInfo aMpdu,
+                                  SignalNoiseDbm signalNoise,
+                                  uint16_t staId);
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_NODE_STATISTICS_H */
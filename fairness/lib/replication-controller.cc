@@ -0,0 +1,287 @@
+#include "replication-controller.h"
+
+#include "sweep-runner.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <sys/wait.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ReplicationController");
+
+ReplicationMetric
+ReplicationMetric::Parse(const std::string& spec)
+{
+    const std::size_t colon = spec.find(':');
+    NS_ABORT_MSG_IF(colon == std::string::npos, "Metric must look like prefix:column, got " << spec);
+    return {spec.substr(0, colon), spec.substr(colon + 1)};
+}
+
+std::string
+ReplicationMetric::GetName() const
+{
+    return prefix + ":" + column;
+}
+
+double
+ReplicationMetric::Read(const std::string& runDir) const
+{
+    double sum = 0;
+    uint32_t n = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(runDir))
+    {
+        const std::string name = entry.path().filename().string();
+        const std::string suffix = "-totals.csv";
+        if (name.rfind(prefix, 0) != 0 || name.size() < suffix.size() ||
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0)
+        {
+            continue;
+        }
+        std::ifstream file(entry.path());
+        std::string header;
+        std::string row;
+        if (!std::getline(file, header) || !std::getline(file, row))
+        {
+            continue;
+        }
+        std::istringstream headerStream(header);
+        std::istringstream rowStream(row);
+        std::string field;
+        std::string value;
+        while (std::getline(headerStream, field, ',') && std::getline(rowStream, value, ','))
+        {
+            if (field == column)
+            {
+                sum += std::stod(value);
+                n++;
+                break;
+            }
+        }
+    }
+    return n > 0 ? sum / n : std::numeric_limits<double>::quiet_NaN();
+}
+
+ReplicationController::ReplicationController(std::string program,
+                                             std::string args,
+                                             std::string outputDir,
+                                             uint32_t jobs)
+    : m_program(std::filesystem::absolute(program).string()),
+      m_args(args),
+      m_outputDir(outputDir),
+      m_jobs(jobs > 0 ? jobs : 1)
+{
+}
+
+void
+ReplicationController::AddMetric(const ReplicationMetric& metric)
+{
+    m_metrics.push_back(metric);
+}
+
+void
+ReplicationController::SetStopping(double width, bool relative, uint32_t minRuns, uint32_t maxRuns)
+{
+    NS_ABORT_MSG_IF(minRuns < 2, "At least two replications are needed for an interval");
+    NS_ABORT_MSG_IF(maxRuns < minRuns, "maxRuns must not be below minRuns");
+    m_width = width;
+    m_relative = relative;
+    m_minRuns = minRuns;
+    m_maxRuns = maxRuns;
+}
+
+const std::vector<ReplicationSummary>&
+ReplicationController::GetSummaries() const
+{
+    return m_summaries;
+}
+
+double
+ReplicationController::GetStudentT95(uint32_t df)
+{
+    static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                                   2.262,  2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120,
+                                   2.110,  2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+                                   2.060,  2.056, 2.052, 2.048, 2.045, 2.042};
+    NS_ABORT_MSG_IF(df == 0, "No degrees of freedom");
+    if (df <= 30)
+    {
+        return table[df - 1];
+    }
+    if (df <= 40)
+    {
+        return 2.021;
+    }
+    if (df <= 60)
+    {
+        return 2.000;
+    }
+    if (df <= 120)
+    {
+        return 1.980;
+    }
+    return 1.960;
+}
+
+bool
+ReplicationController::Summarize(const std::vector<std::vector<double>>& samples)
+{
+    bool converged = true;
+    m_summaries.clear();
+    for (std::size_t m = 0; m < m_metrics.size(); m++)
+    {
+        ReplicationSummary summary;
+        summary.metric = m_metrics[m].GetName();
+        summary.n = samples[m].size();
+        for (double x : samples[m])
+        {
+            summary.mean += x;
+        }
+        if (summary.n > 0)
+        {
+            summary.mean /= summary.n;
+        }
+        if (summary.n > 1)
+        {
+            double squares = 0;
+            for (double x : samples[m])
+            {
+                squares += (x - summary.mean) * (x - summary.mean);
+            }
+            summary.stddev = std::sqrt(squares / (summary.n - 1));
+            summary.halfWidth =
+                GetStudentT95(summary.n - 1) * summary.stddev / std::sqrt(summary.n);
+        }
+        const double target = m_relative ? m_width * std::abs(summary.mean) : m_width;
+        converged &= summary.n >= m_minRuns && 2 * summary.halfWidth <= target;
+        m_summaries.push_back(summary);
+    }
+    return converged;
+}
+
+bool
+ReplicationController::Run(uint32_t firstRun)
+{
+    using Clock = std::chrono::steady_clock;
+    NS_ABORT_MSG_IF(m_metrics.empty(), "No metric to replicate");
+
+    std::filesystem::create_directories(m_outputDir);
+    std::ofstream index(m_outputDir + "/replications.csv");
+    index << "run,status,wall_s";
+    for (const auto& metric : m_metrics)
+    {
+        index << "," << metric.GetName();
+    }
+    index << ",run_dir" << std::endl;
+
+    struct Done
+    {
+        int status;
+        double wallSeconds;
+    };
+    std::map<pid_t, std::pair<uint32_t, Clock::time_point>> running;
+    std::map<uint32_t, Done> done; // Finished runs not taken in order yet
+    std::vector<std::vector<double>> samples(m_metrics.size());
+    uint32_t next = firstRun;
+    uint32_t taken = firstRun;
+    bool converged = false;
+
+    while (!converged && taken - firstRun < m_maxRuns)
+    {
+        while (next - firstRun < m_maxRuns && running.size() < m_jobs)
+        {
+            const std::string runDir = m_outputDir + "/run-" + std::to_string(next);
+            std::filesystem::create_directories(runDir);
+            SweepPoint point{"", "", "", "", next};
+            std::vector<std::string> args = {m_program};
+            std::istringstream argStream(SweepRunner::Expand(m_args, point));
+            for (std::string arg; argStream >> arg;)
+            {
+                args.push_back(arg);
+            }
+            running[LaunchProcess(args, runDir)] = {next++, Clock::now()};
+        }
+
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0)
+        {
+            break;
+        }
+        auto it = running.find(pid);
+        if (it == running.end())
+        {
+            continue;
+        }
+        done[it->second.first] = {
+            WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status),
+            std::chrono::duration<double>(Clock::now() - it->second.second).count()};
+        running.erase(it);
+
+        // Take the finished runs in run number order
+        for (auto first = done.begin(); first != done.end() && first->first == taken;
+             first = done.erase(first), taken++)
+        {
+            const std::string runDir = m_outputDir + "/run-" + std::to_string(taken);
+            index << taken << "," << first->second.status << "," << first->second.wallSeconds;
+            std::vector<double> values;
+            bool valid = first->second.status == 0;
+            for (const auto& metric : m_metrics)
+            {
+                values.push_back(valid ? metric.Read(runDir)
+                                       : std::numeric_limits<double>::quiet_NaN());
+                valid &= !std::isnan(values.back());
+                index << "," << values.back();
+            }
+            index << "," << runDir << std::endl;
+            if (!valid)
+            {
+                NS_LOG_WARN("Run " << taken << " failed or has no results, not counted");
+                continue;
+            }
+            for (std::size_t m = 0; m < values.size(); m++)
+            {
+                samples[m].push_back(values[m]);
+            }
+            converged = Summarize(samples);
+            NS_LOG_INFO("Run " << taken << ": " << samples[0].size() << " replications, "
+                               << m_summaries[0].metric << " " << m_summaries[0].mean << " +- "
+                               << m_summaries[0].halfWidth);
+            if (converged)
+            {
+                taken++;
+                break;
+            }
+        }
+    }
+
+    for (const auto& [pid, run] : running)
+    {
+        NS_LOG_INFO("Stopping run " << run.first << ", not needed");
+        kill(pid, SIGTERM);
+        waitpid(pid, nullptr, 0);
+    }
+
+    Summarize(samples);
+    std::ofstream summary(m_outputDir + "/summary.csv");
+    summary << "metric,n,mean,stddev,ci95_low,ci95_high,converged" << std::endl;
+    for (const auto& s : m_summaries)
+    {
+        summary << s.metric << "," << s.n << "," << s.mean << "," << s.stddev << ","
+                << s.mean - s.halfWidth << "," << s.mean + s.halfWidth << "," << std::boolalpha
+                << converged << std::endl;
+    }
+    return converged;
+}
+
+} // namespace ns3
@@ -0,0 +1,132 @@
+#ifndef FAIRNESS_REPLICATION_CONTROLLER_H
+#define FAIRNESS_REPLICATION_CONTROLLER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * A per-run scalar read from the statistics of the fairness scenario.
+ *
+ * The value of a run is the mean, over the <prefix>*-totals.csv files of the
+ * run (one per STA), of the column of the first flow, i.e. the client flow.
+ */
+struct ReplicationMetric
+{
+    std::string prefix; //!< Totals file prefix, e.g. "tcp-flow".
+    std::string column; //!< Totals column, e.g. "kbps".
+
+    /**
+     * \param spec The metric as prefix:column.
+     * \return The metric.
+     */
+    static ReplicationMetric Parse(const std::string& spec);
+
+    /**
+     * \return The metric as prefix:column.
+     */
+    std::string GetName() const;
+
+    /**
+     * \param runDir The result directory of a run.
+     * \return The value of the run, NaN if it has no matching totals.
+     */
+    double Read(const std::string& runDir) const;
+};
+
+/**
+ * Mean and 95% confidence interval of a metric over the replications.
+ */
+struct ReplicationSummary
+{
+    std::string metric;  //!< Metric name.
+    uint32_t n{0};       //!< Number of replications.
+    double mean{0};      //!< Sample mean.
+    double stddev{0};    //!< Sample standard deviation.
+    double halfWidth{0}; //!< Half-width of the 95% confidence interval.
+};
+
+/**
+ * Runs a scenario with successive run numbers until the confidence intervals
+ * of the chosen metrics are narrow enough.
+ *
+ * Up to `jobs` replications run in parallel as child processes, each in its
+ * own directory below the output directory. Results are taken in run number
+ * order, not completion order, so the stopping point does not depend on
+ * which run happens to finish first. Once every metric has at least
+ * `minRuns` samples and a 95% CI (Student t) narrower than the target width,
+ * or `maxRuns` replications are in, the runs still in flight are killed.
+ */
+class ReplicationController
+{
+  public:
+    /**
+     * \param program Program path.
+     * \param args Argument template, {seed} is replaced by the run number.
+     * \param outputDir Root directory of the per-run result directories.
+     * \param jobs Maximum number of concurrent runs.
+     */
+    ReplicationController(std::string program,
+                          std::string args,
+                          std::string outputDir,
+                          uint32_t jobs);
+
+    /**
+     * \param metric A metric the stopping rule applies to.
+     */
+    void AddMetric(const ReplicationMetric& metric);
+
+    /**
+     * \param width The target full width of the confidence intervals.
+     * \param relative Whether the width is relative to the mean.
+     * \param minRuns The minimum number of replications, at least 2.
+     * \param maxRuns The maximum number of replications.
+     */
+    void SetStopping(double width, bool relative, uint32_t minRuns, uint32_t maxRuns);
+
+    /**
+     * Run the replications and write replications.csv and summary.csv.
+     *
+     * \param firstRun The run number of the first replication.
+     * \return True if every interval reached the target width.
+     */
+    bool Run(uint32_t firstRun);
+
+    /**
+     * \return The summaries of the metrics after Run().
+     */
+    const std::vector<ReplicationSummary>& GetSummaries() const;
+
+    /**
+     * \param df Degrees of freedom.
+     * \return The two-sided 95% quantile of Student's t distribution.
+     */
+    static double GetStudentT95(uint32_t df);
+
+  private:
+    /**
+     * Update the summaries with the samples taken so far.
+     *
+     * \param samples The samples, one vector per metric.
+     * \return True if every interval reached the target width.
+     */
+    bool Summarize(const std::vector<std::vector<double>>& samples);
+
+    std::string m_program;                       //!< Program path.
+    std::string m_args;                          //!< Argument template.
+    std::string m_outputDir;                     //!< Root result directory.
+    uint32_t m_jobs;                             //!< Maximum concurrent runs.
+    std::vector<ReplicationMetric> m_metrics;    //!< Metrics of the stopping rule.
+    double m_width{0.05};                        //!< Target interval width.
+    bool m_relative{true};                       //!< Whether m_width is relative.
+    uint32_t m_minRuns{3};                       //!< Minimum replications.
+    uint32_t m_maxRuns{50};                      //!< Maximum replications.
+    std::vector<ReplicationSummary> m_summaries; //!< Current summaries.
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_REPLICATION_CONTROLLER_H */
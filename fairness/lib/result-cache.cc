@@ -0,0 +1,219 @@
+#include "result-cache.h"
+
+#include "ns3/abort.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/type-id.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <link.h>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ResultCache");
+
+namespace
+{
+
+/// Round constants of SHA-256.
+const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+/// Rotate right.
+uint32_t
+Rotr(uint32_t x, int n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+/// SHA-256 (FIPS 180-4) of a text, 64 hex digits.
+std::string
+Sha256(const std::string& text)
+{
+    uint32_t hash[8] = {0x6a09e667,
+                        0xbb67ae85,
+                        0x3c6ef372,
+                        0xa54ff53a,
+                        0x510e527f,
+                        0x9b05688c,
+                        0x1f83d9ab,
+                        0x5be0cd19};
+    // Padding: a 1 bit, zeros, then the length in bits, to whole 64 byte blocks
+    std::string message = text;
+    message += static_cast<char>(0x80);
+    while (message.size() % 64 != 56)
+    {
+        message += '\0';
+    }
+    const uint64_t bits = static_cast<uint64_t>(text.size()) * 8;
+    for (int i = 7; i >= 0; i--)
+    {
+        message += static_cast<char>(bits >> (8 * i));
+    }
+
+    for (std::size_t block = 0; block < message.size(); block += 64)
+    {
+        uint32_t w[64];
+        for (int i = 0; i < 16; i++)
+        {
+            const auto* bytes = reinterpret_cast<const unsigned char*>(&message[block + 4 * i]);
+            w[i] = (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) |
+                   (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+        }
+        for (int i = 16; i < 64; i++)
+        {
+            const uint32_t s0 = Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const uint32_t s1 = Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t v[8];
+        std::copy(hash, hash + 8, v);
+        for (int i = 0; i < 64; i++)
+        {
+            const uint32_t s1 = Rotr(v[4], 6) ^ Rotr(v[4], 11) ^ Rotr(v[4], 25);
+            const uint32_t choice = (v[4] & v[5]) ^ (~v[4] & v[6]);
+            const uint32_t t1 = v[7] + s1 + choice + SHA256_K[i] + w[i];
+            const uint32_t s0 = Rotr(v[0], 2) ^ Rotr(v[0], 13) ^ Rotr(v[0], 22);
+            const uint32_t majority = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+            std::copy_backward(v, v + 7, v + 8);
+            v[4] += t1;
+            v[0] = t1 + s0 + majority;
+        }
+        for (int i = 0; i < 8; i++)
+        {
+            hash[i] += v[i];
+        }
+    }
+
+    std::ostringstream hex;
+    hex << std::hex << std::setfill('0');
+    for (uint32_t word : hash)
+    {
+        hex << std::setw(8) << word;
+    }
+    return hex.str();
+}
+
+/// Append path, size and modification time of a file.
+void
+DescribeFile(std::ostream& os, const std::string& path)
+{
+    struct stat st = {};
+    if (!path.empty() && stat(path.c_str(), &st) == 0)
+    {
+        os << path << " " << st.st_size << " " << st.st_mtim.tv_sec << "."
+           << st.st_mtim.tv_nsec << "\n";
+    }
+}
+
+int
+DescribeLibrary(struct dl_phdr_info* info, size_t, void* data)
+{
+    DescribeFile(*static_cast<std::ostream*>(data), info->dlpi_name);
+    return 0;
+}
+
+} // namespace
+
+ResultCache::ResultCache(const std::string& cacheDir)
+    : m_cacheDir(cacheDir)
+{
+    std::filesystem::create_directories(m_cacheDir);
+}
+
+std::string
+ResultCache::ComputeKey(const std::string& parameters)
+{
+    std::ostringstream text;
+    text << "[parameters]\n" << parameters;
+
+    text << "[attributes]\n";
+    for (uint16_t i = 0; i < TypeId::GetRegisteredN(); i++)
+    {
+        TypeId tid = TypeId::GetRegistered(i);
+        for (std::size_t j = 0; j < tid.GetAttributeN(); j++)
+        {
+            TypeId::AttributeInformation info = tid.GetAttribute(j);
+            text << tid.GetName() << "::" << info.name << " = "
+                 << info.initialValue->SerializeToString(info.checker) << "\n";
+        }
+    }
+
+    text << "[globals]\n";
+    for (auto it = GlobalValue::Begin(); it != GlobalValue::End(); ++it)
+    {
+        StringValue value;
+        (*it)->GetValue(value);
+        text << (*it)->GetName() << " = " << value.Get() << "\n";
+    }
+
+    text << "[build]\n";
+    std::error_code error;
+    DescribeFile(text, std::filesystem::read_symlink("/proc/self/exe", error).string());
+    dl_iterate_phdr(&DescribeLibrary, &text);
+
+    return Sha256(text.str());
+}
+
+std::string
+ResultCache::GetEntry(const std::string& key) const
+{
+    return m_cacheDir + "/" + key;
+}
+
+bool
+ResultCache::Contains(const std::string& key) const
+{
+    return std::filesystem::is_directory(GetEntry(key));
+}
+
+std::string
+ResultCache::Reserve(const std::string& key) const
+{
+    const std::string runDir = m_cacheDir + "/.tmp-" + key + "-" + std::to_string(getpid());
+    std::filesystem::remove_all(runDir);
+    std::filesystem::create_directories(runDir);
+    return runDir;
+}
+
+void
+ResultCache::Commit(const std::string& key, const std::string& runDir) const
+{
+    std::error_code error;
+    std::filesystem::rename(runDir, GetEntry(key), error);
+    if (error)
+    {
+        NS_ABORT_MSG_UNLESS(Contains(key),
+                            "Cannot store " << runDir << " in the cache: " << error.message());
+        NS_LOG_INFO("Entry " << key << " was stored by another run, keeping it");
+        std::filesystem::remove_all(runDir);
+        return;
+    }
+    NS_LOG_INFO("Stored entry " << key);
+}
+
+void
+ResultCache::Restore(const std::string& key, const std::string& outputDir) const
+{
+    std::filesystem::create_directories(outputDir);
+    std::filesystem::copy(GetEntry(key),
+                          outputDir,
+                          std::filesystem::copy_options::recursive |
+                              std::filesystem::copy_options::overwrite_existing);
+}
+
+} // namespace ns3
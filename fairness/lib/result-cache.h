@@ -0,0 +1,81 @@
+#ifndef FAIRNESS_RESULT_CACHE_H
+#define FAIRNESS_RESULT_CACHE_H
+
+#include <cstdint>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * Content-addressed store of scenario results.
+ *
+ * A run is keyed by the SHA-256 of its parameters, of the current default
+ * value of every registered attribute and global value, and of the build:
+ * path, size and modification time of the executable and of every loaded
+ * library. A run
+ * writes to a private directory that is renamed to <cacheDir>/<key> once it
+ * is complete, so an entry that exists is always whole, and concurrent runs
+ * of the same key do not clash.
+ */
+class ResultCache
+{
+  public:
+    /**
+     * \param cacheDir The cache root directory.
+     */
+    ResultCache(const std::string& cacheDir);
+
+    /**
+     * Compute the key of a run. Must be called after the attribute defaults
+     * have been set, e.g. by the command line.
+     *
+     * \param parameters The run parameters in text form.
+     * \return The key, 64 hex digits.
+     */
+    static std::string ComputeKey(const std::string& parameters);
+
+    /**
+     * \param key A run key.
+     * \return True if the cache holds a complete entry for the key.
+     */
+    bool Contains(const std::string& key) const;
+
+    /**
+     * Create the private directory a run of the key writes to.
+     *
+     * \param key The run key.
+     * \return The directory.
+     */
+    std::string Reserve(const std::string& key) const;
+
+    /**
+     * Publish the results of a run as the entry of its key. If another run
+     * of the key got there first, its entry is kept.
+     *
+     * \param key The run key.
+     * \param runDir The directory returned by Reserve().
+     */
+    void Commit(const std::string& key, const std::string& runDir) const;
+
+    /**
+     * Copy the entry of a key to a result directory.
+     *
+     * \param key The run key.
+     * \param outputDir The result directory, created if needed.
+     */
+    void Restore(const std::string& key, const std::string& outputDir) const;
+
+  private:
+    /**
+     * \param key A run key.
+     * \return The entry directory of the key.
+     */
+    std::string GetEntry(const std::string& key) const;
+
+    std::string m_cacheDir; //!< Cache root directory.
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_RESULT_CACHE_H */
@@ -0,0 +1,215 @@
+#include "results-database.h"
+
+#include "ns3/abort.h"
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef HAVE_SQLITE3
+#include <sqlite3.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ResultsDatabase");
+
+#ifdef HAVE_SQLITE3
+
+ResultsDatabase::ResultsDatabase(const std::string& fileName,
+                                 const std::string& runId,
+                                 const std::string& parameters,
+                                 uint32_t batchSize)
+    : m_runId(runId),
+      m_batchSize(batchSize > 0 ? batchSize : 1)
+{
+    NS_ABORT_MSG_UNLESS(sqlite3_open(fileName.c_str(), &m_db) == SQLITE_OK,
+                        "Cannot open " << fileName << ": " << sqlite3_errmsg(m_db));
+    // Concurrent runs wait for each other's transactions instead of failing
+    sqlite3_busy_timeout(m_db, 60000);
+    Exec("PRAGMA journal_mode = WAL;"
+         "PRAGMA synchronous = NORMAL;");
+    Exec("BEGIN IMMEDIATE;"
+         "CREATE TABLE IF NOT EXISTS runs ("
+         "run_id TEXT PRIMARY KEY, parameters TEXT);"
+         "CREATE TABLE IF NOT EXISTS metrics ("
+         "run_id TEXT, protocol TEXT, flow TEXT, direction TEXT, step INTEGER, "
+         "kbps REAL, jitter_mils REAL, plr REAL, delay_mils REAL, "
+         "pkt_sent INTEGER, pkt_rcv INTEGER, signal REAL, noise REAL, "
+         "source TEXT, dest TEXT, "
+         "delay_p50_mils REAL, delay_p90_mils REAL, delay_p99_mils REAL, "
+         "jitter_p50_mils REAL, jitter_p90_mils REAL, jitter_p99_mils REAL);"
+         "CREATE INDEX IF NOT EXISTS metrics_run ON metrics (run_id, protocol, step);"
+         "CREATE INDEX IF NOT EXISTS metrics_protocol ON metrics (protocol, step);"
+         "COMMIT;");
+
+    sqlite3_stmt* run = nullptr;
+    sqlite3_prepare_v2(m_db, "INSERT OR REPLACE INTO runs VALUES (?, ?);", -1, &run, nullptr);
+    sqlite3_bind_text(run, 1, m_runId.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(run, 2, parameters.c_str(), -1, SQLITE_TRANSIENT);
+    NS_ABORT_MSG_UNLESS(sqlite3_step(run) == SQLITE_DONE,
+                        "Cannot register run " << m_runId << ": " << sqlite3_errmsg(m_db));
+    sqlite3_finalize(run);
+
+    NS_ABORT_MSG_UNLESS(
+        sqlite3_prepare_v2(m_db,
+                           "INSERT INTO metrics VALUES "
+                           "(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);",
+                           -1,
+                           &m_insert,
+                           nullptr) == SQLITE_OK,
+        "Cannot prepare the metrics insert: " << sqlite3_errmsg(m_db));
+    m_pending.reserve(m_batchSize);
+}
+
+ResultsDatabase::~ResultsDatabase()
+{
+    Flush();
+    sqlite3_finalize(m_insert);
+    sqlite3_close(m_db);
+}
+
+void
+ResultsDatabase::Exec(const std::string& sql)
+{
+    char* error = nullptr;
+    if (sqlite3_exec(m_db, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK)
+    {
+        const std::string message = error != nullptr ? error : sqlite3_errmsg(m_db);
+        sqlite3_free(error);
+        NS_FATAL_ERROR("SQLite error: " << message);
+    }
+}
+
+void
+ResultsDatabase::Insert(const MetricsRow& row)
+{
+    m_pending.push_back(row);
+    if (m_pending.size() >= m_batchSize)
+    {
+        Flush();
+    }
+}
+
+void
+ResultsDatabase::Flush()
+{
+    if (m_pending.empty())
+    {
+        return;
+    }
+    Exec("BEGIN IMMEDIATE;");
+    for (const MetricsRow& row : m_pending)
+    {
+        sqlite3_bind_text(m_insert, 1, m_runId.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(m_insert, 2, row.protocol.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(m_insert, 3, row.flow.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(m_insert, 4, row.direction.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_int(m_insert, 5, row.step);
+        sqlite3_bind_double(m_insert, 6, row.kbps);
+        sqlite3_bind_double(m_insert, 7, row.jitterMs);
+        sqlite3_bind_double(m_insert, 8, row.plr);
+        sqlite3_bind_double(m_insert, 9, row.delayMs);
+        sqlite3_bind_int64(m_insert, 10, row.sent);
+        sqlite3_bind_int64(m_insert, 11, row.received);
+        sqlite3_bind_double(m_insert, 12, row.signal);
+        sqlite3_bind_double(m_insert, 13, row.noise);
+        sqlite3_bind_text(m_insert, 14, row.source.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(m_insert, 15, row.dest.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_double(m_insert, 16, row.delayP50Ms);
+        sqlite3_bind_double(m_insert, 17, row.delayP90Ms);
+        sqlite3_bind_double(m_insert, 18, row.delayP99Ms);
+        sqlite3_bind_double(m_insert, 19, row.jitterP50Ms);
+        sqlite3_bind_double(m_insert, 20, row.jitterP90Ms);
+        sqlite3_bind_double(m_insert, 21, row.jitterP99Ms);
+        NS_ABORT_MSG_UNLESS(sqlite3_step(m_insert) == SQLITE_DONE,
+                            "Cannot insert metrics: " << sqlite3_errmsg(m_db));
+        sqlite3_reset(m_insert);
+    }
+    Exec("COMMIT;");
+    NS_LOG_INFO("Inserted " << m_pending.size() << " rows for run " << m_runId);
+    m_pending.clear();
+}
+
+#else
+
+ResultsDatabase::ResultsDatabase(const std::string& fileName,
+                                 const std::string&,
+                                 const std::string&,
+                                 uint32_t)
+    : m_batchSize(0)
+{
+    NS_FATAL_ERROR("Cannot write " << fileName << ": ns-3 was built without SQLite");
+}
+
+ResultsDatabase::~ResultsDatabase()
+{
+}
+
+void
+ResultsDatabase::Exec(const std::string&)
+{
+}
+
+void
+ResultsDatabase::Insert(const MetricsRow&)
+{
+}
+
+void
+ResultsDatabase::Flush()
+{
+}
+
+#endif
+
+void
+ResultsDatabase::InsertCsv(const std::string& fileName)
+{
+    const std::string stem = std::filesystem::path(fileName).stem().string();
+    const std::size_t dash = stem.rfind('-');
+    NS_ABORT_MSG_IF(dash == std::string::npos, "Not a metrics file: " << fileName);
+    MetricsRow row;
+    row.flow = stem.substr(0, dash);
+    row.direction = stem.substr(dash + 1);
+    row.protocol = row.flow.substr(0, row.flow.find('-'));
+
+    std::ifstream file(fileName);
+    NS_ABORT_MSG_UNLESS(file, "Cannot read " << fileName);
+    std::string line;
+    std::getline(file, line); // Header
+    while (std::getline(file, line))
+    {
+        std::vector<std::string> fields;
+        std::istringstream lineStream(line);
+        for (std::string field; std::getline(lineStream, field, ',');)
+        {
+            fields.push_back(field);
+        }
+        NS_ABORT_MSG_IF(fields.size() < 19, "Short row in " << fileName << ": " << line);
+        // pdr and pkt_loss, columns 4 and 8, are not stored
+        row.step = std::stoi(fields[0]);
+        row.kbps = std::stod(fields[1]);
+        row.jitterMs = std::stod(fields[2]);
+        row.plr = std::stod(fields[3]);
+        row.delayMs = std::stod(fields[5]);
+        row.sent = std::stoull(fields[6]);
+        row.received = std::stoull(fields[7]);
+        row.signal = std::stod(fields[9]);
+        row.noise = std::stod(fields[10]);
+        row.source = fields[11];
+        row.dest = fields[12];
+        row.delayP50Ms = std::stod(fields[13]);
+        row.delayP90Ms = std::stod(fields[14]);
+        row.delayP99Ms = std::stod(fields[15]);
+        row.jitterP50Ms = std::stod(fields[16]);
+        row.jitterP90Ms = std::stod(fields[17]);
+        row.jitterP99Ms = std::stod(fields[18]);
+        Insert(row);
+    }
+}
+
+} // namespace ns3
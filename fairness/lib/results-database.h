@@ -0,0 +1,109 @@
+#ifndef FAIRNESS_RESULTS_DATABASE_H
+#define FAIRNESS_RESULTS_DATABASE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace ns3
+{
+
+/**
+ * One row of per-step flow metrics, as in the -client.csv and -server.csv
+ * files of NodeStatistics.
+ */
+struct MetricsRow
+{
+    std::string protocol;  //!< tcp, quic or udp.
+    std::string flow;      //!< Flow name, e.g. tcp-flow0.
+    std::string direction; //!< client or server.
+    int step;              //!< Step number.
+    double kbps;           //!< Throughput over the step.
+    double jitterMs;       //!< Jitter sum over the step (ms).
+    double plr;            //!< Packet loss ratio (%).
+    double delayMs;        //!< Delay of the last packet (ms).
+    uint64_t sent;         //!< Packets sent.
+    uint64_t received;     //!< Packets received.
+    double signal;         //!< Last signal power (dBm).
+    double noise;          //!< Last noise power (dBm).
+    std::string source;    //!< Source address.
+    std::string dest;      //!< Destination address.
+    double delayP50Ms;     //!< Median delay (ms).
+    double delayP90Ms;     //!< 90th percentile delay (ms).
+    double delayP99Ms;     //!< 99th percentile delay (ms).
+    double jitterP50Ms;    //!< Median jitter (ms).
+    double jitterP90Ms;    //!< 90th percentile jitter (ms).
+    double jitterP99Ms;    //!< 99th percentile jitter (ms).
+};
+
+/**
+ * SQLite database of the results of a sweep.
+ *
+ * Every run of a sweep writes into the same file: a row in the runs table
+ * with its parameters, and its per-step metrics in the metrics table, which
+ * is indexed by run id, protocol and step. The database is in WAL mode, so
+ * readers do not block the runs. Rows are buffered and inserted
+ * `batchSize` at a time in one write transaction, which keeps the write lock
+ * short when many runs share the file. Needs ns-3 built with SQLite.
+ */
+class ResultsDatabase
+{
+  public:
+    /**
+     * Open or create the database and register the run.
+     *
+     * \param fileName The database file.
+     * \param runId The run id, see RunManifest.
+     * \param parameters The run parameters in INI form.
+     * \param batchSize Rows per transaction.
+     */
+    ResultsDatabase(const std::string& fileName,
+                    const std::string& runId,
+                    const std::string& parameters,
+                    uint32_t batchSize = 1000);
+
+    /// Flush and close.
+    ~ResultsDatabase();
+
+    /**
+     * Buffer a metrics row, flushing once the batch is full.
+     *
+     * \param row The row.
+     */
+    void Insert(const MetricsRow& row);
+
+    /**
+     * Insert the rows of a -client.csv or -server.csv file of NodeStatistics,
+     * e.g. of a run restored from a ResultCache. The flow, direction and
+     * protocol come from the file name, e.g. tcp-flow0-client.csv.
+     *
+     * \param fileName The CSV file.
+     */
+    void InsertCsv(const std::string& fileName);
+
+    /**
+     * Insert the buffered rows in one transaction.
+     */
+    void Flush();
+
+  private:
+    /**
+     * Run SQL statements, aborting on error.
+     *
+     * \param sql The statements.
+     */
+    void Exec(const std::string& sql);
+
+    sqlite3* m_db{nullptr};            //!< Connection.
+    sqlite3_stmt* m_insert{nullptr};   //!< Prepared metrics insert.
+    std::string m_runId;               //!< Run id of the rows.
+    uint32_t m_batchSize;              //!< Rows per transaction.
+    std::vector<MetricsRow> m_pending; //!< Rows not yet inserted.
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_RESULTS_DATABASE_H */
@@ -0,0 +1,127 @@
+#include "run-manifest.h"
+
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+namespace ns3
+{
+
+namespace
+{
+
+/// Format a wall time as local ISO 8601.
+std::string
+FormatTime(std::chrono::system_clock::time_point time)
+{
+    std::time_t t = std::chrono::system_clock::to_time_t(time);
+    struct tm localTime;
+    localtime_r(&t, &localTime);
+    std::ostringstream os;
+    os << std::put_time(&localTime, "%Y-%m-%dT%H:%M:%S%z");
+    return os.str();
+}
+
+} // namespace
+
+std::string
+AllocateRunDirectory(const std::string& parent)
+{
+    std::filesystem::create_directories(parent);
+
+    std::time_t unixNow = std::time(0);
+    struct tm localTime;
+    localtime_r(&unixNow, &localTime);
+    std::stringstream prefix;
+    prefix << std::put_time(&localTime, "%Y-%m-%d_%H:%M:%S") << "-" << getpid();
+
+    // create_directory() is false if the directory already exists
+    std::string runId = prefix.str();
+    for (uint32_t sequence = 1; !std::filesystem::create_directory(parent + "/" + runId);
+         sequence++)
+    {
+        runId = prefix.str() + "-" + std::to_string(sequence);
+    }
+    return runId;
+}
+
+RunManifest::RunManifest(const std::string& runDir, const std::string& runId)
+    : m_fileName(runDir + "/manifest.ini"),
+      m_runId(runId),
+      m_start(std::chrono::system_clock::now()),
+      m_startSteady(std::chrono::steady_clock::now())
+{
+    Write("running");
+}
+
+void
+RunManifest::SetCommandLine(int argc, char* argv[])
+{
+    m_commandLine.clear();
+    for (int i = 0; i < argc; i++)
+    {
+        m_commandLine += (i > 0 ? " " : "") + std::string(argv[i]);
+    }
+    Write("running");
+}
+
+void
+RunManifest::SetParameters(const std::string& parameters)
+{
+    m_parameters = parameters;
+    Write("running");
+}
+
+void
+RunManifest::SetCacheHit(const std::string& key)
+{
+    m_cacheHit = key;
+    Write("running");
+}
+
+void
+RunManifest::Finish(int exitStatus)
+{
+    m_end = std::chrono::system_clock::now();
+    m_wallSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startSteady).count();
+    m_events = Simulator::GetEventCount();
+    m_exitStatus = exitStatus;
+    Write("done");
+}
+
+void
+RunManifest::Write(const std::string& status) const
+{
+    // Written aside and renamed, so a reader never sees a partial manifest
+    const std::string tmpName = m_fileName + ".tmp";
+    std::ofstream os(tmpName);
+    os << "run_id = " << m_runId << "\n"
+       << "status = " << status << "\n"
+       << "exit_status = " << m_exitStatus << "\n"
+       << "command_line = " << m_commandLine << "\n"
+       << "seed = " << RngSeedManager::GetSeed() << "\n"
+       << "run = " << RngSeedManager::GetRun() << "\n"
+       << "start = " << FormatTime(m_start) << "\n";
+    if (!m_cacheHit.empty())
+    {
+        os << "cache_hit = " << m_cacheHit << "\n";
+    }
+    if (status == "done")
+    {
+        os << "end = " << FormatTime(m_end) << "\n"
+           << "wall_s = " << m_wallSeconds << "\n"
+           << "events = " << m_events << "\n";
+    }
+    os << "\n[parameters]\n" << m_parameters;
+    os.close();
+    std::filesystem::rename(tmpName, m_fileName);
+}
+
+} // namespace ns3
@@ -0,0 +1,95 @@
+#ifndef FAIRNESS_RUN_MANIFEST_H
+#define FAIRNESS_RUN_MANIFEST_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * Create a new run directory under a parent directory.
+ *
+ * The run id is the start time, as in the legacy timestamp folders, followed
+ * by the process id and, if needed, a sequence number. The directory is
+ * created with an exclusive mkdir, so runs started in the same second, in
+ * the same or in different processes, never share a directory.
+ *
+ * \param parent The parent directory, created if needed.
+ * \return The run id; the directory is <parent>/<run id>.
+ */
+std::string AllocateRunDirectory(const std::string& parent);
+
+/**
+ * The manifest.ini of a run: its id, command line, parameters, RNG seed and
+ * run number, start and end wall time, simulator events processed and exit
+ * status.
+ *
+ * The manifest is written once when created, with status = running, and
+ * again by Finish(). A run that crashed is left marked as running. A run
+ * restored from the result cache records the key of the entry as cache_hit.
+ */
+class RunManifest
+{
+  public:
+    /**
+     * \param runDir The run directory.
+     * \param runId The run id.
+     */
+    RunManifest(const std::string& runDir, const std::string& runId);
+
+    /**
+     * Set the command line and rewrite the manifest.
+     *
+     * \param argc Argument count.
+     * \param argv Argument vector.
+     */
+    void SetCommandLine(int argc, char* argv[]);
+
+    /**
+     * Set the run parameters and rewrite the manifest.
+     *
+     * \param parameters The parameters in INI form, one name = value per line.
+     */
+    void SetParameters(const std::string& parameters);
+
+    /**
+     * Mark the run as restored from the result cache and rewrite the manifest.
+     *
+     * \param key The result cache key of the entry.
+     */
+    void SetCacheHit(const std::string& key);
+
+    /**
+     * Record the end of the run. Must be called before Simulator::Destroy(),
+     * which resets the event count.
+     *
+     * \param exitStatus The exit status of the run.
+     */
+    void Finish(int exitStatus);
+
+  private:
+    /**
+     * Write the manifest.
+     *
+     * \param status The run status, running or done.
+     */
+    void Write(const std::string& status) const;
+
+    std::string m_fileName;                              //!< Manifest file.
+    std::string m_runId;                                 //!< Run id.
+    std::string m_commandLine;                           //!< Command line.
+    std::string m_parameters;                            //!< Parameters in INI form.
+    std::string m_cacheHit;                              //!< Cache key, if restored.
+    std::chrono::system_clock::time_point m_start;       //!< Start wall time.
+    std::chrono::system_clock::time_point m_end;         //!< End wall time.
+    std::chrono::steady_clock::time_point m_startSteady; //!< Start, for the duration.
+    double m_wallSeconds{0};                             //!< Wall duration (s).
+    uint64_t m_events{0};                                //!< Events processed.
+    int m_exitStatus{-1};                                //!< Exit status, -1 while running.
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_RUN_MANIFEST_H */
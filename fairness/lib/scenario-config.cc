@@ -0,0 +1,268 @@
+#include "scenario-config.h"
+
+#include "ns3/abort.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace ns3
+{
+
+namespace
+{
+
+std::string
+Trim(const std::string& s)
+{
+    const std::size_t first = s.find_first_not_of(" \t\r");
+    if (first == std::string::npos)
+    {
+        return "";
+    }
+    const std::size_t last = s.find_last_not_of(" \t\r");
+    return s.substr(first, last - first + 1);
+}
+
+} // namespace
+
+template <typename Self, typename F>
+void
+ScenarioConfig::Visit(Self& self, F&& f)
+{
+    f("transport_prot", "TCP/QUIC congestion control TypeId", self.transport_prot);
+    f("nTcp", "Number of TCP STAs", self.nTcp);
+    f("nQuic", "Number of QUIC STAs", self.nQuic);
+    f("nUdp", "Number of UDP STAs", self.nUdp);
+    f("mix", "Protocol pair a-b, overrides the counts and start times", self.mix);
+    f("steps", "Number of measurement steps", self.steps);
+    f("initPos", "Initial STA distance from the AP (m)", self.initPos);
+    f("stepsSize", "STA displacement per step (m)", self.stepsSize);
+    f("stepsTime", "Step duration (s)", self.stepsTime);
+    f("tcpStart", "TCP application start time (s)", self.tcpStart);
+    f("udpStart", "UDP application start time (s)", self.udpStart);
+    f("quicStart", "QUIC application start time (s)", self.quicStart);
+    f("startTime", "Start time of the first protocol of a mix (s)", self.startTime);
+    f("lateStart", "Start time of the second protocol of a mix (s)", self.lateStart);
+    f("port", "Server port", self.port);
+    f("propagationDelay", "WiFi propagation delay model", self.propagationDelay);
+    f("propagationLoss", "WiFi propagation loss model", self.propagationLoss);
+    f("cullChannel", "Skip the WiFi receivers out of range of each transmission", self.cullChannel);
+    f("cachePropagation", "Cache the propagation loss and delay between nodes until they move", self.cachePropagation);
+    f("errorTable", "Look the WiFi chunk success rates up in precomputed tables", self.errorTable);
+    f("p2pApGwDataRate", "AP-GW link data rate", self.p2pApGwDataRate);
+    f("p2pApGwDelay", "AP-GW link delay", self.p2pApGwDelay);
+    f("p2pGwServerDataRate", "GW-server link data rate", self.p2pGwServerDataRate);
+    f("p2pGwServerDelay", "GW-server link delay", self.p2pGwServerDelay);
+    f("direction", "Traffic direction: up, down or both", self.direction);
+    f("isDoubleStream", "Also record the reverse flow of each STA", self.isDoubleStream);
+    f("application", "Traffic source: onoff or bulksend", self.application);
+    f("bsMaxByte", "Bulk send MaxBytes, 0 for unlimited", self.bsMaxByte);
+    f("onOffDownRate", "Downstream on/off data rate", self.onOffDownRate);
+    f("onOffUpRate", "Upstream on/off data rate", self.onOffUpRate);
+    f("ofOnTime", "On/off application on time (s), always on if empty", self.ofOnTime);
+    f("ofOffTime", "On/off application off time (s), never off if empty", self.ofOffTime);
+    f("onOffPktSize", "On/off application packet size (bytes)", self.onOffPktSize);
+    f("errorRate", "Packet error rate on the AP-GW link", self.errorRate);
+    f("run", "Run number for the RNG", self.run);
+    f("outputDir", "Output directory, a timestamped one if empty", self.outputDir);
+    f("pcap", "Enable pcap tracing on the AP-GW link", self.pcap);
+    f("profile", "Per-event-type profile file, relative to the output directory", self.profile);
+    f("forkTime", "Warm start: time the shared prefix runs to before forking (s)", self.forkTime);
+    f("branch", "Warm start: parameter set per branch", self.branch);
+    f("branchValues", "Warm start: comma separated branch values, off if empty", self.branchValues);
+    f("steadyWindow", "Stop once this many steps are stable, 0 to always run to the end", self.steadyWindow);
+    f("steadyTolerance", "Relative throughput and absolute Jain's index range of a stable window", self.steadyTolerance);
+    f("cache", "Result cache directory, off if empty", self.cache);
+    f("database", "SQLite results database shared by a sweep, off if empty", self.database);
+    f("delayBinWidth", "Delay histogram bin width of the per-step percentiles (s)", self.delayBinWidth);
+    f("jitterBinWidth", "Jitter histogram bin width of the per-step percentiles (s)", self.jitterBinWidth);
+}
+
+void
+ScenarioConfig::Parse(int argc, char* argv[])
+{
+    std::string config;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg.rfind("--config=", 0) == 0)
+        {
+            config = arg.substr(9);
+        }
+    }
+
+    // The INI entries go first so that the command line overrides them
+    std::vector<std::string> args = {argv[0]};
+    if (!config.empty())
+    {
+        std::vector<std::string> ini = ReadIni(config);
+        args.insert(args.end(), ini.begin(), ini.end());
+    }
+    args.insert(args.end(), argv + 1, argv + argc);
+
+    // Keep the attribute defaults, e.g. --ns3::TcpSocket::SegmentSize=1448,
+    // for Write(); later ones override earlier ones as in CommandLine
+    for (std::size_t i = 1; i < args.size(); i++)
+    {
+        const std::size_t eq = args[i].find('=');
+        if (args[i].rfind("--", 0) != 0 || eq == std::string::npos)
+        {
+            continue;
+        }
+        const std::string name = args[i].substr(2, eq - 2);
+        const std::size_t scope = name.rfind("::");
+        if (scope != std::string::npos)
+        {
+            attributes[name.substr(0, scope)][name.substr(scope + 2)] = args[i].substr(eq + 1);
+        }
+    }
+
+    CommandLine cmd;
+    cmd.AddValue("config", "INI scenario file", config);
+    Visit(*this, [&cmd](const std::string& name, const std::string& help, auto& field) {
+        cmd.AddValue(name, help, field);
+    });
+    cmd.Parse(args);
+
+    ApplyMix();
+}
+
+void
+ScenarioConfig::ApplyMix()
+{
+    NS_ABORT_MSG_UNLESS(direction == "up" || direction == "down" || direction == "both",
+                        "Unknown direction " << direction);
+    NS_ABORT_MSG_UNLESS(application == "onoff" || application == "bulksend",
+                        "Unknown application " << application);
+    if (mix.empty())
+    {
+        return;
+    }
+    const std::size_t dash = mix.find('-');
+    NS_ABORT_MSG_IF(dash == std::string::npos, "Mix must look like a-b, got " << mix);
+    const std::string first = mix.substr(0, dash);
+    const std::string second = mix.substr(dash + 1);
+    NS_ABORT_MSG_IF(first == second, "Mix must name two different protocols, got " << mix);
+
+    nTcp = nQuic = nUdp = 0;
+    for (const auto& [protocol, start] : {std::make_pair(first, startTime),
+                                          std::make_pair(second, lateStart)})
+    {
+        if (protocol == "tcp")
+        {
+            nTcp = 1;
+            tcpStart = start;
+        }
+        else if (protocol == "quic")
+        {
+            nQuic = 1;
+            quicStart = start;
+        }
+        else if (protocol == "udp")
+        {
+            nUdp = 1;
+            udpStart = start;
+        }
+        else
+        {
+            NS_FATAL_ERROR("Unknown protocol " << protocol << " in mix " << mix);
+        }
+    }
+}
+
+void
+ScenarioConfig::Set(const std::string& name, const std::string& value)
+{
+    bool found = false;
+    Visit(*this, [&](const std::string& fieldName, const std::string&, auto& field) {
+        if (fieldName == name)
+        {
+            std::istringstream is(value);
+            is >> std::boolalpha >> field;
+            NS_ABORT_MSG_IF(is.fail(), "Bad value " << value << " for " << name);
+            found = true;
+        }
+    });
+    NS_ABORT_MSG_UNLESS(found, "Unknown parameter " << name);
+}
+
+bool
+ScenarioConfig::IsWarmStart() const
+{
+    return !branchValues.empty();
+}
+
+int
+ScenarioConfig::GetSimuTime() const
+{
+    return steps * stepsTime + stepsTime;
+}
+
+bool
+ScenarioConfig::IsUpstream() const
+{
+    return direction == "up" || direction == "both";
+}
+
+bool
+ScenarioConfig::IsDownstream() const
+{
+    return direction == "down" || direction == "both";
+}
+
+void
+ScenarioConfig::Write(std::ostream& os) const
+{
+    os << std::boolalpha;
+    Visit(*this, [&os](const std::string& name, const std::string&, const auto& field) {
+        os << name << " = " << field << "\n";
+    });
+    for (const auto& [typeId, values] : attributes)
+    {
+        os << "\n[" << typeId << "]\n";
+        for (const auto& [name, value] : values)
+        {
+            os << name << " = " << value << "\n";
+        }
+    }
+}
+
+std::vector<std::string>
+ScenarioConfig::ReadIni(const std::string& fileName)
+{
+    std::ifstream file(fileName);
+    NS_ABORT_MSG_UNLESS(file.is_open(), "Cannot open scenario file " << fileName);
+
+    std::vector<std::string> args;
+    std::string section;
+    std::string line;
+    for (int lineNo = 1; std::getline(file, line); lineNo++)
+    {
+        line = Trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == ';')
+        {
+            continue;
+        }
+        if (line.front() == '[' && line.back() == ']')
+        {
+            section = Trim(line.substr(1, line.size() - 2));
+            continue;
+        }
+        const std::size_t eq = line.find('=');
+        NS_ABORT_MSG_IF(eq == std::string::npos,
+                        fileName << ":" << lineNo << ": expected key = value");
+        const std::string key = Trim(line.substr(0, eq));
+        const std::string value = Trim(line.substr(eq + 1));
+        if (section.empty() || section == "scenario")
+        {
+            args.push_back("--" + key + "=" + value);
+        }
+        else
+        {
+            args.push_back("--" + section + "::" + key + "=" + value);
+        }
+    }
+    return args;
+}
+
+} // namespace ns3
@@ -0,0 +1,155 @@
+#ifndef FAIRNESS_SCENARIO_CONFIG_H
+#define FAIRNESS_SCENARIO_CONFIG_H
+
+#include "ns3/command-line.h"
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Parameters of the single-AP WiFi fairness scenario.
+ *
+ * The names and defaults are the locals of the legacy base-of.cc mains. Values
+ * come from an INI scenario file (--config=file.ini) and are then overridden by
+ * the command line. In the INI file, keys outside a section or in [scenario]
+ * are scenario parameters; any other section is taken as a TypeId and its keys
+ * set that type's attribute defaults, e.g.
+ *
+ *   mix = tcp-quic
+ *   initPos = 35
+ *
+ *   [ns3::TcpSocket]
+ *   SegmentSize = 1448
+ */
+struct ScenarioConfig
+{
+    std::string transport_prot = "ns3::TcpNewReno";
+    int nTcp = 1;
+    int nQuic = 1;
+    int nUdp = 0;
+    std::string mix = "";
+    int steps = 20;
+    int initPos = 5;
+    int stepsSize = 0;
+    int stepsTime = 1;
+    double tcpStart = 0.5;
+    double udpStart = 0.5;
+    double quicStart = 10.5;
+    double startTime = 0.5;
+    double lateStart = 10.5;
+    uint16_t port = 443;
+    std::string propagationDelay = "ns3::ConstantSpeedPropagationDelayModel";
+    std::string propagationLoss = "ns3::LogDistancePropagationLossModel";
+    bool cullChannel = false;
+    bool cachePropagation = false;
+    bool errorTable = false;
+    std::string p2pApGwDataRate = "1Gbps";
+    std::string p2pApGwDelay = "2ms";
+    std::string p2pGwServerDataRate = "1Gbps";
+    std::string p2pGwServerDelay = "2ms";
+    std::string direction = "up";
+    bool isDoubleStream = false;
+    std::string application = "onoff";
+    uint32_t bsMaxByte = 0;
+    std::string onOffDownRate = "100Mb/s";
+    std::string onOffUpRate = "100Mb/s";
+    std::string ofOnTime = "";
+    std::string ofOffTime = "";
+    int onOffPktSize = 1420;
+    double errorRate = 0.0;
+    uint32_t run = 1;
+    std::string outputDir = "";
+    bool pcap = false;
+    std::string profile = "";
+    double forkTime = 0;
+    std::string branch = "initPos";
+    std::string branchValues = "";
+    int steadyWindow = 0;
+    double steadyTolerance = 0.05;
+    std::string cache = "";
+    std::string database = "";
+    double delayBinWidth = 0.001;
+    double jitterBinWidth = 0.001;
+    /// Attribute defaults set by the INI sections and the command line, by TypeId then name
+    std::map<std::string, std::map<std::string, std::string>> attributes;
+
+    /**
+     * Parse an optional --config file and the command line into this config.
+     *
+     * \param argc Argument count.
+     * \param argv Argument vector.
+     */
+    void Parse(int argc, char* argv[]);
+
+    /**
+     * Derive the per-protocol counts and start times from mix, if set.
+     *
+     * A mix "a-b" runs one flow of protocol a starting at startTime and one
+     * flow of protocol b starting at lateStart; the third protocol is off.
+     */
+    void ApplyMix();
+
+    /**
+     * Set a parameter from its text form.
+     *
+     * \param name The parameter name.
+     * \param value The value.
+     */
+    void Set(const std::string& name, const std::string& value);
+
+    /**
+     * \return True if the run forks into branches, see WifiFairnessScenario.
+     */
+    bool IsWarmStart() const;
+
+    /**
+     * \return The simulated duration in seconds.
+     */
+    int GetSimuTime() const;
+
+    /**
+     * \return True if the STAs send towards the servers.
+     */
+    bool IsUpstream() const;
+
+    /**
+     * \return True if the servers send towards the STAs.
+     */
+    bool IsDownstream() const;
+
+    /**
+     * Write the effective parameters in INI form, followed by one section per
+     * TypeId of the attribute defaults, so a run can be repeated with --config.
+     *
+     * \param os The output stream.
+     */
+    void Write(std::ostream& os) const;
+
+    /**
+     * Translate an INI scenario file to command line arguments.
+     *
+     * \param fileName The INI file.
+     * \return One --key=value argument per entry.
+     */
+    static std::vector<std::string> ReadIni(const std::string& fileName);
+
+  private:
+    /**
+     * Call f(name, help, field) for every parameter.
+     *
+     * \param self The config, const or not.
+     * \param f The visitor.
+     */
+    template <typename Self, typename F>
+    static void Visit(Self& self, F&& f);
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_SCENARIO_CONFIG_H */
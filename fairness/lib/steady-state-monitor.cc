@@ -0,0 +1,159 @@
+#include "steady-state-monitor.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SteadyStateMonitor");
+
+SteadyStateMonitor::SteadyStateMonitor(uint32_t window, double tolerance, Time startTime)
+    : m_window(window),
+      m_tolerance(tolerance),
+      m_startTime(startTime)
+{
+    NS_ABORT_MSG_IF(window < 2, "The steady state window needs at least two steps");
+}
+
+void
+SteadyStateMonitor::Record(const std::string& flow, double kbps)
+{
+    if (!m_pending)
+    {
+        // Runs after the events already scheduled for now, i.e. after the
+        // statistics of every flow for this step
+        m_pending = true;
+        m_current.time = Simulator::Now();
+        Simulator::ScheduleNow(&SteadyStateMonitor::EndStep, this);
+    }
+    m_current.kbps[flow] = kbps;
+}
+
+void
+SteadyStateMonitor::EndStep()
+{
+    m_pending = false;
+    Step step;
+    std::swap(step, m_current);
+    if (step.time < m_startTime)
+    {
+        return;
+    }
+
+    std::vector<double> values;
+    for (const auto& [flow, kbps] : step.kbps)
+    {
+        values.push_back(kbps);
+    }
+    step.jain = GetJainIndex(values);
+    m_steps.push_back(step);
+    m_nSteps++;
+    if (m_steps.size() > m_window)
+    {
+        m_steps.pop_front();
+    }
+
+    if (m_steps.size() == m_window && IsStable())
+    {
+        NS_LOG_INFO("Steady state after " << m_nSteps << " steps, Jain's index " << step.jain
+                                          << ", stopping at " << Simulator::Now().As(Time::S));
+        m_stoppedEarly = true;
+        m_stopTime = Simulator::Now();
+        // Behind the other end of step events of this time, e.g. the
+        // FairnessMonitor one, so the step that stops the run is written
+        Simulator::Stop(Seconds(0));
+    }
+}
+
+bool
+SteadyStateMonitor::IsStable() const
+{
+    const Step& last = m_steps.back();
+    double minJain = last.jain;
+    double maxJain = last.jain;
+    for (const Step& step : m_steps)
+    {
+        if (step.kbps.size() != last.kbps.size())
+        {
+            return false;
+        }
+        minJain = std::min(minJain, step.jain);
+        maxJain = std::max(maxJain, step.jain);
+    }
+    if (maxJain - minJain > m_tolerance)
+    {
+        return false;
+    }
+
+    for (const auto& [flow, kbps] : last.kbps)
+    {
+        double min = kbps;
+        double max = kbps;
+        double sum = 0;
+        for (const Step& step : m_steps)
+        {
+            auto it = step.kbps.find(flow);
+            if (it == step.kbps.end())
+            {
+                return false;
+            }
+            min = std::min(min, it->second);
+            max = std::max(max, it->second);
+            sum += it->second;
+        }
+        const double mean = sum / m_steps.size();
+        if (max - min > m_tolerance * mean)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+SteadyStateMonitor::IsStoppedEarly() const
+{
+    return m_stoppedEarly;
+}
+
+void
+SteadyStateMonitor::WriteSummary(const std::string& fileName) const
+{
+    std::ofstream summary(fileName);
+    NS_ABORT_MSG_UNLESS(summary.is_open(), "Cannot open " << fileName);
+    summary << std::boolalpha;
+    summary << "stoppedEarly = " << m_stoppedEarly << "\n";
+    summary << "stopTime = " << (m_stoppedEarly ? m_stopTime : Simulator::Now()).GetSeconds()
+            << "\n";
+    summary << "steps = " << m_nSteps << "\n";
+    summary << "window = " << m_window << "\n";
+    summary << "tolerance = " << m_tolerance << "\n";
+    if (!m_steps.empty())
+    {
+        summary << "jain = " << m_steps.back().jain << "\n";
+    }
+}
+
+double
+GetJainIndex(const std::vector<double>& values)
+{
+    double sum = 0;
+    double sumSquares = 0;
+    for (double x : values)
+    {
+        sum += x;
+        sumSquares += x * x;
+    }
+    if (sumSquares == 0)
+    {
+        return 1;
+    }
+    return sum * sum / (values.size() * sumSquares);
+}
+
+} // namespace ns3
@@ -0,0 +1,99 @@
+#ifndef FAIRNESS_STEADY_STATE_MONITOR_H
+#define FAIRNESS_STEADY_STATE_MONITOR_H
+
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Stops the simulation once the per-step throughput has converged.
+ *
+ * The per-step statistics Record() the throughput of each flow. After all
+ * records of a step, the monitor computes Jain's fairness index over the
+ * flows of the step. The run is stable, and the simulation stops after the
+ * other events of the current time, once over the last `window` steps the
+ * flow set has not changed, the throughput of every flow stayed within
+ * `tolerance` of its mean (relative range) and the fairness index within
+ * `tolerance` (absolute range). Steps before the start time, e.g. before the
+ * last flow started, are ignored.
+ */
+class SteadyStateMonitor
+{
+  public:
+    /**
+     * \param window The number of steps that must be stable.
+     * \param tolerance The allowed range, relative for throughput, absolute
+     * for the fairness index.
+     * \param startTime The time of the first step to consider.
+     */
+    SteadyStateMonitor(uint32_t window, double tolerance, Time startTime);
+
+    /**
+     * Record the throughput of a flow in the current step.
+     *
+     * \param flow The flow name.
+     * \param kbps The throughput over the step.
+     */
+    void Record(const std::string& flow, double kbps);
+
+    /**
+     * \return True if the monitor stopped the simulation.
+     */
+    bool IsStoppedEarly() const;
+
+    /**
+     * Write whether and when the run stopped early, in INI form.
+     *
+     * \param fileName The file to write.
+     */
+    void WriteSummary(const std::string& fileName) const;
+
+  private:
+    /**
+     * The records of one step.
+     */
+    struct Step
+    {
+        Time time;                          //!< Time of the step.
+        std::map<std::string, double> kbps; //!< Throughput by flow.
+        double jain{1};                     //!< Jain's index over the flows.
+    };
+
+    /**
+     * Close the current step and stop the simulation if the window is stable.
+     */
+    void EndStep();
+
+    /**
+     * \return True if the steps of the window are stable.
+     */
+    bool IsStable() const;
+
+    uint32_t m_window;          //!< Steps that must be stable.
+    double m_tolerance;         //!< Allowed range.
+    Time m_startTime;           //!< Time of the first considered step.
+    Step m_current;             //!< Records of the current step.
+    bool m_pending{false};      //!< Whether EndStep is scheduled.
+    std::deque<Step> m_steps;   //!< The last window steps.
+    uint32_t m_nSteps{0};       //!< Steps considered so far.
+    bool m_stoppedEarly{false}; //!< Whether the monitor stopped the run.
+    Time m_stopTime;            //!< Time of the stop.
+};
+
+/**
+ * \param values Per-flow throughputs.
+ * \return Jain's fairness index (sum x)^2 / (n sum x^2), 1 for no or all-zero
+ * values.
+ */
+double GetJainIndex(const std::vector<double>& values);
+
+} // namespace ns3
+
+#endif /* FAIRNESS_STEADY_STATE_MONITOR_H */
@@ -0,0 +1,245 @@
+#include "sweep-runner.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <chrono>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SweepRunner");
+
+namespace
+{
+
+/**
+ * Make an argument that names an existing file relative to the working
+ * directory absolute, as a whole or as the value of a --name=value option.
+ *
+ * \param arg The argument.
+ * \return The argument, with the path made absolute if it was one.
+ */
+std::string
+AbsoluteFileArgument(const std::string& arg)
+{
+    const std::size_t equals = arg.find('=');
+    const std::size_t start =
+        (arg.compare(0, 2, "--") == 0 && equals != std::string::npos) ? equals + 1 : 0;
+    const std::filesystem::path path = arg.substr(start);
+    std::error_code error;
+    if (path.empty() || path.is_absolute() || !std::filesystem::is_regular_file(path, error))
+    {
+        return arg;
+    }
+    return arg.substr(0, start) + std::filesystem::absolute(path).string();
+}
+
+} // namespace
+
+std::size_t
+SweepGrid::GetN() const
+{
+    return mixes.size() * distances.size() * directions.size() * rates.size() * seeds.size();
+}
+
+SweepPoint
+SweepGrid::Get(std::size_t i) const
+{
+    // Seeds vary fastest, so replications of one configuration run side by side
+    SweepPoint point;
+    point.seed = seeds[i % seeds.size()];
+    i /= seeds.size();
+    point.rate = rates[i % rates.size()];
+    i /= rates.size();
+    point.direction = directions[i % directions.size()];
+    i /= directions.size();
+    point.distance = distances[i % distances.size()];
+    i /= distances.size();
+    point.mix = mixes[i % mixes.size()];
+    return point;
+}
+
+SweepRunner::SweepRunner(std::string program, std::string args, std::string outputDir, uint32_t jobs)
+    : m_program(program),
+      m_args(args),
+      m_outputDir(outputDir),
+      m_jobs(jobs > 0 ? jobs : 1)
+{
+}
+
+std::string
+SweepRunner::Expand(const std::string& tmpl, const SweepPoint& point)
+{
+    const std::map<std::string, std::string> values = {
+        {"{mix}", point.mix},
+        {"{distance}", point.distance},
+        {"{direction}", point.direction},
+        {"{rate}", point.rate},
+        {"{seed}", std::to_string(point.seed)},
+    };
+    std::string out = tmpl;
+    for (const auto& [key, value] : values)
+    {
+        for (std::size_t pos = out.find(key); pos != std::string::npos;
+             pos = out.find(key, pos + value.size()))
+        {
+            out.replace(pos, key.size(), value);
+        }
+    }
+    return out;
+}
+
+std::string
+SweepRunner::GetRunDir(const SweepPoint& point)
+{
+    std::string rate = point.rate;
+    for (auto& c : rate)
+    {
+        if (c == '/')
+        {
+            c = 'p';
+        }
+    }
+    return point.mix + "/" + point.distance + "-" + point.direction + "/" + rate + "/run-" +
+           std::to_string(point.seed);
+}
+
+pid_t
+SweepRunner::Launch(const SweepPoint& point, const std::string& runDir) const
+{
+    std::string program = std::filesystem::absolute(Expand(m_program, point)).string();
+    std::vector<std::string> args = {program};
+    std::istringstream argStream(Expand(m_args, point));
+    for (std::string arg; argStream >> arg;)
+    {
+        args.push_back(arg);
+    }
+    return LaunchProcess(args, runDir);
+}
+
+std::vector<SweepResult>
+SweepRunner::Run(const SweepGrid& grid)
+{
+    using Clock = std::chrono::steady_clock;
+    struct Pending
+    {
+        SweepPoint point;
+        std::string runDir;
+        Clock::time_point start;
+    };
+
+    std::filesystem::create_directories(m_outputDir);
+    std::ofstream index(m_outputDir + "/sweep.csv");
+    index << "mix,distance,direction,rate,seed,status,wall_s,run_dir" << std::endl;
+
+    const std::size_t total = grid.GetN();
+    std::size_t next = 0;
+    std::map<pid_t, Pending> running;
+    std::vector<SweepResult> results;
+    results.reserve(total);
+
+    while (next < total || !running.empty())
+    {
+        while (next < total && running.size() < m_jobs)
+        {
+            SweepPoint point = grid.Get(next++);
+            std::string runDir = m_outputDir + "/" + GetRunDir(point);
+            std::filesystem::create_directories(runDir);
+            pid_t pid = Launch(point, runDir);
+            running[pid] = {point, runDir, Clock::now()};
+        }
+
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0)
+        {
+            break;
+        }
+        auto it = running.find(pid);
+        if (it == running.end())
+        {
+            continue;
+        }
+        SweepResult result;
+        result.point = it->second.point;
+        result.runDir = it->second.runDir;
+        result.exitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+        result.wallSeconds =
+            std::chrono::duration<double>(Clock::now() - it->second.start).count();
+        running.erase(it);
+
+        NS_LOG_INFO("[" << results.size() + 1 << "/" << total << "] " << result.runDir
+                        << " status " << result.exitStatus << " in " << result.wallSeconds
+                        << "s");
+        // Flushed per run so an interrupted sweep still has a usable index
+        index << result.point.mix << "," << result.point.distance << ","
+              << result.point.direction << "," << result.point.rate << "," << result.point.seed
+              << "," << result.exitStatus << "," << result.wallSeconds << "," << result.runDir
+              << std::endl;
+        results.push_back(result);
+    }
+    return results;
+}
+
+pid_t
+LaunchProcess(std::vector<std::string> args, const std::string& runDir)
+{
+    // The child runs in its result directory, so input files given relative
+    // to this one, e.g. --config=scenarios/tcp-quic.ini, are made absolute
+    std::vector<char*> argv;
+    for (auto& arg : args)
+    {
+        arg = AbsoluteFileArgument(arg);
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid = fork();
+    NS_ABORT_MSG_IF(pid < 0, "fork failed for " << runDir);
+    if (pid == 0)
+    {
+        // Child: only async-signal-safe calls from here on
+        if (chdir(runDir.c_str()) != 0)
+        {
+            _exit(126);
+        }
+        int out = open("stdout.log", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int err = open("stderr.log", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (out < 0 || err < 0)
+        {
+            _exit(126);
+        }
+        dup2(out, STDOUT_FILENO);
+        dup2(err, STDERR_FILENO);
+        close(out);
+        close(err);
+        execv(argv[0], argv.data());
+        _exit(127);
+    }
+    return pid;
+}
+
+std::vector<std::string>
+SplitList(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::istringstream stream(list);
+    for (std::string item; std::getline(stream, item, ',');)
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+} // namespace ns3
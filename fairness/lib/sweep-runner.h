@@ -0,0 +1,146 @@
+#ifndef FAIRNESS_SWEEP_RUNNER_H
+#define FAIRNESS_SWEEP_RUNNER_H
+
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * One point of the fairness sweep grid.
+ */
+struct SweepPoint
+{
+    std::string mix;       //!< Protocol pair, e.g. "tcp-quic".
+    std::string distance;  //!< STA distance from the AP in meters.
+    std::string direction; //!< Traffic direction, "up" or "down".
+    std::string rate;      //!< On/off data rate, e.g. "100Mb/s".
+    uint32_t seed;         //!< Run number handed to the RNG.
+};
+
+/**
+ * Cartesian product of the sweep axes.
+ *
+ * Points are decoded from their index on demand, so a large grid is never
+ * materialized in memory.
+ */
+class SweepGrid
+{
+  public:
+    std::vector<std::string> mixes;      //!< Protocol pairs.
+    std::vector<std::string> distances;  //!< STA distances.
+    std::vector<std::string> directions; //!< Traffic directions.
+    std::vector<std::string> rates;      //!< On/off data rates.
+    std::vector<uint32_t> seeds;         //!< Run numbers.
+
+    /**
+     * \return The number of points in the grid.
+     */
+    std::size_t GetN() const;
+
+    /**
+     * \param i The point index, in [0, GetN()).
+     * \return The i-th point of the grid.
+     */
+    SweepPoint Get(std::size_t i) const;
+};
+
+/**
+ * Result of a single sweep run.
+ */
+struct SweepResult
+{
+    SweepPoint point;   //!< The grid point.
+    std::string runDir; //!< Directory the run wrote its output to.
+    int exitStatus;     //!< Exit code, or 128 + signal number if killed.
+    double wallSeconds; //!< Wall-clock duration of the run.
+};
+
+/**
+ * Runs sweep points as independent child processes.
+ *
+ * At most `jobs` children are alive at any time; the next point is only taken
+ * from the grid once a slot frees up. Every run gets its own result directory
+ * below the output directory, which is also the child's working directory, and
+ * its stdout/stderr are captured there.
+ */
+class SweepRunner
+{
+  public:
+    /**
+     * \param program Program path template, may contain placeholders.
+     * \param args Argument template, split on whitespace after expansion.
+     * \param outputDir Root directory of the per-run result directories.
+     * \param jobs Maximum number of concurrent runs.
+     */
+    SweepRunner(std::string program, std::string args, std::string outputDir, uint32_t jobs);
+
+    /**
+     * Run every point of the grid and write the sweep index.
+     *
+     * \param grid The grid to run.
+     * \return The results, in completion order.
+     */
+    std::vector<SweepResult> Run(const SweepGrid& grid);
+
+    /**
+     * Expand the {mix}, {distance}, {direction}, {rate} and {seed}
+     * placeholders of a template.
+     *
+     * \param tmpl The template.
+     * \param point The point providing the values.
+     * \return The expanded string.
+     */
+    static std::string Expand(const std::string& tmpl, const SweepPoint& point);
+
+    /**
+     * \param point The point.
+     * \return The result directory of the point, relative to the output directory.
+     */
+    static std::string GetRunDir(const SweepPoint& point);
+
+  private:
+    /**
+     * Fork and exec one run.
+     *
+     * \param point The point to run.
+     * \param runDir The result directory of the run.
+     * \return The child pid.
+     */
+    pid_t Launch(const SweepPoint& point, const std::string& runDir) const;
+
+    std::string m_program;   //!< Program path template.
+    std::string m_args;      //!< Argument template.
+    std::string m_outputDir; //!< Root result directory.
+    uint32_t m_jobs;         //!< Maximum concurrent runs.
+};
+
+/**
+ * Fork and exec a program in its result directory, with its stdout and
+ * stderr captured to stdout.log and stderr.log there.
+ *
+ * Arguments that name an existing file relative to the working directory of
+ * the caller, alone or as the value of a --name=value option, are made
+ * absolute. Other relative paths, such as --outputDir=., stay relative to the
+ * result directory.
+ *
+ * \param args The absolute program path followed by its arguments.
+ * \param runDir The result directory, which must exist.
+ * \return The child pid.
+ */
+pid_t LaunchProcess(std::vector<std::string> args, const std::string& runDir);
+
+/**
+ * Split a comma separated list, dropping empty items.
+ *
+ * \param list The list.
+ * \return The items.
+ */
+std::vector<std::string> SplitList(const std::string& list);
+
+} // namespace ns3
+
+#endif /* FAIRNESS_SWEEP_RUNNER_H */
@@ -0,0 +1,274 @@
+#include "tabulated-error-rate-model.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/object-factory.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TabulatedErrorRateModel");
+
+NS_OBJECT_ENSURE_REGISTERED(TabulatedErrorRateModel);
+
+namespace
+{
+
+/// Log of the success rates that round to zero.
+const double MIN_LOG_SUCCESS = -700;
+
+/// Index of the chunk size bucket, floor(log2(bits)).
+uint32_t
+GetBucket(uint64_t bits)
+{
+    uint32_t bucket = 0;
+    while (bits >>= 1)
+    {
+        bucket++;
+    }
+    return bucket;
+}
+
+} // namespace
+
+TypeId
+TabulatedErrorRateModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TabulatedErrorRateModel")
+            .SetParent<ErrorRateModel>()
+            .SetGroupName("Wifi")
+            .AddConstructor<TabulatedErrorRateModel>()
+            .AddAttribute("Model",
+                          "TypeId of the error rate model to tabulate",
+                          StringValue("ns3::TableBasedErrorRateModel"),
+                          MakeStringAccessor(&TabulatedErrorRateModel::m_modelName),
+                          MakeStringChecker())
+            .AddAttribute("MinSnr",
+                          "First SNR of the tables (dB)",
+                          DoubleValue(-10),
+                          MakeDoubleAccessor(&TabulatedErrorRateModel::m_minSnrDb),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("MaxSnr",
+                          "Last SNR of the tables (dB)",
+                          DoubleValue(50),
+                          MakeDoubleAccessor(&TabulatedErrorRateModel::m_maxSnrDb),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("SnrStep",
+                          "SNR step of the tables (dB)",
+                          DoubleValue(0.05),
+                          MakeDoubleAccessor(&TabulatedErrorRateModel::m_snrStepDb),
+                          MakeDoubleChecker<double>(0.001))
+            .AddAttribute("TableFile",
+                          "File the tables are loaded from and saved to, none if empty",
+                          StringValue(""),
+                          MakeStringAccessor(&TabulatedErrorRateModel::m_tableFile),
+                          MakeStringChecker());
+    return tid;
+}
+
+double
+TabulatedErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
+                                               const WifiTxVector& txVector,
+                                               double snr,
+                                               uint64_t nbits,
+                                               uint8_t numRxAntennas,
+                                               WifiPpduField field,
+                                               uint16_t staId) const
+{
+    Setup();
+    const double position = (10 * std::log10(snr) - m_minSnrDb) / m_snrStepDb;
+    // Also catches a NaN SNR
+    if (nbits == 0 || !(position >= 0 && position < m_points - 1))
+    {
+        return m_model
+            ->GetChunkSuccessRate(mode, txVector, snr, nbits, numRxAntennas, field, staId);
+    }
+
+    // Chunks at or above the size threshold of the model have their own table
+    const uint32_t bucket = GetBucket(nbits);
+    const bool large = m_splitBits > 0 && nbits >= m_splitBits;
+    const uint64_t referenceBits =
+        large ? std::max(uint64_t(1) << bucket, m_splitBits) : uint64_t(1) << bucket;
+    const bool ldpc = txVector.IsLdpc();
+    const uint64_t key = (static_cast<uint64_t>(mode.GetUid()) << 24) |
+                         (static_cast<uint64_t>(field) << 16) |
+                         (static_cast<uint64_t>(numRxAntennas) << 8) |
+                         (static_cast<uint64_t>(large) << 7) | (static_cast<uint64_t>(ldpc) << 6) |
+                         bucket;
+    auto it = m_byKey.find(key);
+    if (it == m_byKey.end())
+    {
+        std::ostringstream name;
+        name << mode.GetUniqueName() << " " << static_cast<int>(field) << " "
+             << static_cast<int>(numRxAntennas) << " " << bucket << " " << ldpc << " " << large;
+        auto [named, inserted] = m_tables->byName.try_emplace(name.str());
+        if (inserted)
+        {
+            named->second = Build(mode, txVector, referenceBits, numRxAntennas, field, staId);
+            m_tables->added = true;
+        }
+        it = m_byKey.emplace(key, &named->second).first;
+    }
+
+    const Table& table = *it->second;
+    const uint32_t i = static_cast<uint32_t>(position);
+    const double fraction = position - i;
+    const double logSuccess = table[i] + (table[i + 1] - table[i]) * fraction;
+    const double scale = static_cast<double>(nbits) / static_cast<double>(referenceBits);
+    return std::exp(logSuccess * scale);
+}
+
+int64_t
+TabulatedErrorRateModel::DoAssignStreams(int64_t stream)
+{
+    Setup();
+    return m_model->AssignStreams(stream);
+}
+
+void
+TabulatedErrorRateModel::DoDispose()
+{
+    // The first instance disposed saves the tables of all of them
+    if (m_tables && m_tables->added && !m_tableFile.empty())
+    {
+        Save();
+        m_tables->added = false;
+    }
+    m_model = nullptr;
+    m_tables = nullptr;
+    m_byKey.clear();
+    ErrorRateModel::DoDispose();
+}
+
+std::map<std::string, TabulatedErrorRateModel::TableSet>&
+TabulatedErrorRateModel::GetTableSets()
+{
+    static std::map<std::string, TableSet> tableSets;
+    return tableSets;
+}
+
+void
+TabulatedErrorRateModel::Setup() const
+{
+    if (m_model)
+    {
+        return;
+    }
+    ObjectFactory factory(m_modelName);
+    m_model = factory.Create<ErrorRateModel>();
+    m_points = static_cast<uint32_t>(std::floor((m_maxSnrDb - m_minSnrDb) / m_snrStepDb)) + 1;
+    // TableBasedErrorRateModel switches tables at this size (bytes)
+    TypeId::AttributeInformation info;
+    if (m_model->GetInstanceTypeId().LookupAttributeByName("SizeThreshold", &info))
+    {
+        UintegerValue threshold;
+        m_model->GetAttribute("SizeThreshold", threshold);
+        m_splitBits = threshold.Get() * 8;
+    }
+
+    auto [tables, inserted] = GetTableSets().try_emplace(GetFileHeader() + "\n" + m_tableFile);
+    m_tables = &tables->second;
+    if (inserted && !m_tableFile.empty())
+    {
+        Load();
+    }
+}
+
+TabulatedErrorRateModel::Table
+TabulatedErrorRateModel::Build(WifiMode mode,
+                               const WifiTxVector& txVector,
+                               uint64_t bits,
+                               uint8_t numRxAntennas,
+                               WifiPpduField field,
+                               uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << mode << bits << +numRxAntennas << field);
+    Table table(m_points);
+    for (uint32_t i = 0; i < m_points; i++)
+    {
+        const double snr = std::pow(10.0, (m_minSnrDb + i * m_snrStepDb) / 10);
+        const double success =
+            m_model->GetChunkSuccessRate(mode, txVector, snr, bits, numRxAntennas, field, staId);
+        table[i] = success > 0 ? std::max(std::log(success), MIN_LOG_SUCCESS) : MIN_LOG_SUCCESS;
+    }
+    return table;
+}
+
+std::string
+TabulatedErrorRateModel::GetFileHeader() const
+{
+    std::ostringstream header;
+    header << std::setprecision(17) << "model=" << m_modelName << " min=" << m_minSnrDb
+           << " step=" << m_snrStepDb << " points=" << m_points << " split=" << m_splitBits
+           << " key=mode,field,antennas,bucket,ldpc,large";
+    return header.str();
+}
+
+void
+TabulatedErrorRateModel::Load() const
+{
+    std::ifstream is(m_tableFile);
+    std::string line;
+    if (!std::getline(is, line) || line != GetFileHeader())
+    {
+        NS_LOG_INFO("No tables for this model and grid in " << m_tableFile);
+        return;
+    }
+    // One table per line: the key fields of the header, then the values
+    while (std::getline(is, line))
+    {
+        std::istringstream fields(line);
+        std::string name;
+        for (int i = 0; i < 6; i++)
+        {
+            std::string keyField;
+            fields >> keyField;
+            name += (i ? " " : "") + keyField;
+        }
+        Table table;
+        double value;
+        while (fields >> value)
+        {
+            table.push_back(value);
+        }
+        if (table.size() == m_points)
+        {
+            m_tables->byName[name] = table;
+        }
+    }
+    NS_LOG_INFO("Loaded " << m_tables->byName.size() << " tables from " << m_tableFile);
+}
+
+void
+TabulatedErrorRateModel::Save() const
+{
+    // Written aside and renamed, so concurrent runs never read a partial file
+    const std::string tmpName = m_tableFile + ".tmp-" + std::to_string(getpid());
+    std::ofstream os(tmpName);
+    os << GetFileHeader() << "\n" << std::setprecision(17);
+    for (const auto& [name, table] : m_tables->byName)
+    {
+        os << name;
+        for (double value : table)
+        {
+            os << " " << value;
+        }
+        os << "\n";
+    }
+    os.close();
+    std::filesystem::rename(tmpName, m_tableFile);
+    NS_LOG_INFO("Saved " << m_tables->byName.size() << " tables to " << m_tableFile);
+}
+
+} // namespace ns3
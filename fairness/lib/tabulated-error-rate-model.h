@@ -0,0 +1,130 @@
+#ifndef FAIRNESS_TABULATED_ERROR_RATE_MODEL_H
+#define FAIRNESS_TABULATED_ERROR_RATE_MODEL_H
+
+#include "ns3/error-rate-model.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Error rate model that looks the chunk success rate of another model up in
+ * precomputed tables.
+ *
+ * A table holds the log of the success rate of one mode, PPDU field, number
+ * of RX antennas and coding (BCC or LDPC), for a reference chunk size, on a
+ * grid of SnrStep from MinSnr to MaxSnr. A chunk of n bits in [2^k, 2^(k+1))
+ * takes the value at its SNR, linearly interpolated between the grid points,
+ * scaled by n over the reference size. The reference size is 2^k, or the
+ * SizeThreshold of the model in bits if it falls in the bucket and the chunk
+ * is at or above it. A TableBasedErrorRateModel thus never mixes its small
+ * and large frame tables in one table. The other TX vector parameters are
+ * taken as those of the first chunk of a table. SNRs outside the grid go to
+ * the model itself.
+ *
+ * The scaling is exact for the (1 - BER)^n form of the YANS and NIST models.
+ * TableBasedErrorRateModel scales its PER by whole bytes, so chunks that are
+ * not whole bytes get slightly different rates from it.
+ *
+ * Tables are built from the model on first use. All the instances with the
+ * same model, grid and TableFile in a process share them, so a PHY per STA
+ * builds each table only once. With TableFile, they are loaded from that file
+ * when it matches the model and the grid, and the file is rewritten on the
+ * first dispose after tables were added, so later runs skip the computation.
+ */
+class TabulatedErrorRateModel : public ErrorRateModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+  private:
+    /// Log of the success rate at the grid points
+    using Table = std::vector<double>;
+
+    /**
+     * Tables of one model, grid and table file, shared by the instances.
+     */
+    struct TableSet
+    {
+        std::map<std::string, Table> byName; //!< Tables by name.
+        bool added{false};                   //!< Tables built since the last Load() or Save().
+    };
+
+    double DoGetChunkSuccessRate(WifiMode mode,
+                                 const WifiTxVector& txVector,
+                                 double snr,
+                                 uint64_t nbits,
+                                 uint8_t numRxAntennas,
+                                 WifiPpduField field,
+                                 uint16_t staId) const override;
+    int64_t DoAssignStreams(int64_t stream) override;
+    void DoDispose() override;
+
+    /**
+     * \return The table sets of the process, by file header and table file.
+     */
+    static std::map<std::string, TableSet>& GetTableSets();
+
+    /**
+     * Create the model and find the shared tables, loading the table file
+     * the first time, on first use.
+     */
+    void Setup() const;
+
+    /**
+     * Build a table from the model.
+     *
+     * \param mode The mode.
+     * \param txVector The TX vector.
+     * \param bits The chunk size.
+     * \param numRxAntennas The number of RX antennas.
+     * \param field The PPDU field.
+     * \param staId The station ID.
+     * \return The table.
+     */
+    Table Build(WifiMode mode,
+                const WifiTxVector& txVector,
+                uint64_t bits,
+                uint8_t numRxAntennas,
+                WifiPpduField field,
+                uint16_t staId) const;
+
+    /**
+     * \return The first line of the table file, with the model and the grid.
+     */
+    std::string GetFileHeader() const;
+
+    /**
+     * Load the tables of the table file, if it matches.
+     */
+    void Load() const;
+
+    /**
+     * Write all the tables to the table file.
+     */
+    void Save() const;
+
+    std::string m_modelName;                                    //!< TypeId of the model.
+    double m_minSnrDb;                                          //!< First grid point (dB).
+    double m_maxSnrDb;                                          //!< Last grid point (dB).
+    double m_snrStepDb;                                         //!< Grid step (dB).
+    std::string m_tableFile;                                    //!< Table file, none if empty.
+    mutable Ptr<ErrorRateModel> m_model;                        //!< Tabulated model.
+    mutable uint32_t m_points{0};                               //!< Grid points.
+    mutable uint64_t m_splitBits{0};                            //!< Model size threshold, or 0.
+    mutable TableSet* m_tables{nullptr};                        //!< Shared tables.
+    mutable std::unordered_map<uint64_t, const Table*> m_byKey; //!< Tables by mode UID.
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_TABULATED_ERROR_RATE_MODEL_H */
@@ -0,0 +1,512 @@
+#include "trace-summarizer.h"
+
+#include "binary-trace.h"
+#include "steady-state-monitor.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <thread>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TraceSummarizer");
+
+namespace
+{
+
+/// Statistics file suffixes and the direction of their flows.
+const std::vector<std::pair<std::string, std::string>> STATISTICS_SUFFIXES = {
+    {"-client", "client"},
+    {"-server", "server"},
+    {"-metrics", "client"},
+};
+
+/// Statistics columns of the base-of and theta families, by metric.
+const std::map<std::string, std::string> STATISTICS_COLUMNS = {
+    {"kbps", "kbps"},
+    {"plr", "plr"},
+    {"delay_mils", "delay_mils"},
+    {"del", "delay_mils"},
+    {"jitter_mils", "jitter_mils"},
+    {"jtr", "jitter_mils"},
+    {"delay_p50_mils", "delay_p50_mils"},
+    {"delay_p90_mils", "delay_p90_mils"},
+    {"delay_p99_mils", "delay_p99_mils"},
+    {"jitter_p50_mils", "jitter_p50_mils"},
+    {"jitter_p90_mils", "jitter_p90_mils"},
+    {"jitter_p99_mils", "jitter_p99_mils"},
+    {"del_p50", "delay_p50_mils"},
+    {"del_p90", "delay_p90_mils"},
+    {"del_p99", "delay_p99_mils"},
+    {"jtr_p50", "jitter_p50_mils"},
+    {"jtr_p90", "jitter_p90_mils"},
+    {"jtr_p99", "jitter_p99_mils"},
+};
+
+/**
+ * Tell whether a file is summarized, and of which flow.
+ *
+ * \param path The file.
+ * \param flow The flow name.
+ * \param direction The flow direction, or "cwnd" for a window trace.
+ * \return True if the file is summarized.
+ */
+bool
+Classify(const std::filesystem::path& path, std::string& flow, std::string& direction)
+{
+    const std::string extension = path.extension().string();
+    const std::string stem = path.stem().string();
+    if (extension == ".csv")
+    {
+        for (const auto& [suffix, flowDirection] : STATISTICS_SUFFIXES)
+        {
+            if (stem.size() > suffix.size() &&
+                stem.compare(stem.size() - suffix.size(), suffix.size(), suffix) == 0)
+            {
+                flow = stem.substr(0, stem.size() - suffix.size());
+                direction = flowDirection;
+                return true;
+            }
+        }
+    }
+    if ((extension == ".csv" || extension == ".txt" || extension == ".btr") &&
+        stem.find("cwnd") != std::string::npos)
+    {
+        const std::size_t cwnd = stem.find("-cwnd");
+        flow = cwnd == std::string::npos || cwnd == 0 ? stem : stem.substr(0, cwnd);
+        direction = "cwnd";
+        return true;
+    }
+    return false;
+}
+
+/**
+ * \param flow A flow name.
+ * \return The name without its trailing digits, e.g. tcp-flow for tcp-flow3.
+ */
+std::string
+GetFlowClass(const std::string& flow)
+{
+    const std::size_t last = flow.find_last_not_of("0123456789");
+    return last == std::string::npos ? flow : flow.substr(0, last + 1);
+}
+
+/**
+ * \param run A run path.
+ * \return Its path up to the first run-<n> component, or else its parent.
+ */
+std::string
+GetGroup(const std::string& run)
+{
+    const std::filesystem::path path(run);
+    std::filesystem::path group;
+    for (const auto& component : path)
+    {
+        if (component.string().rfind("run-", 0) == 0)
+        {
+            return group.empty() ? "." : group.generic_string();
+        }
+        group /= component;
+    }
+    group = path.parent_path();
+    return group.empty() ? "." : group.generic_string();
+}
+
+/**
+ * Split a line on commas, tabs and spaces, in place.
+ *
+ * \param line The line.
+ * \param fields The start of every field.
+ */
+void
+SplitFields(std::string& line, std::vector<const char*>& fields)
+{
+    fields.clear();
+    bool inField = false;
+    for (char& c : line)
+    {
+        if (c == ',' || c == '\t' || c == ' ' || c == '\r')
+        {
+            // Commas delimit empty fields, runs of blanks do not
+            if (c == ',' && !inField)
+            {
+                fields.push_back(&c);
+            }
+            c = '\0';
+            inField = false;
+        }
+        else if (!inField)
+        {
+            fields.push_back(&c);
+            inField = true;
+        }
+    }
+}
+
+/**
+ * \param field A field.
+ * \param value The parsed value.
+ * \return True if the whole field is a number.
+ */
+bool
+ParseNumber(const char* field, double& value)
+{
+    char* end = nullptr;
+    value = std::strtod(field, &end);
+    return end != field && *end == '\0';
+}
+
+} // namespace
+
+QuantileSketch::QuantileSketch(double accuracy)
+    : m_logGamma(std::log((1 + accuracy) / (1 - accuracy)))
+{
+}
+
+void
+QuantileSketch::Add(double value)
+{
+    m_count++;
+    if (value <= std::numeric_limits<double>::min())
+    {
+        m_zeroCount++;
+        return;
+    }
+    m_buckets[int(std::ceil(std::log(value) / m_logGamma))]++;
+}
+
+void
+QuantileSketch::Merge(const QuantileSketch& other)
+{
+    NS_ASSERT_MSG(m_logGamma == other.m_logGamma, "Sketches of different accuracy");
+    m_count += other.m_count;
+    m_zeroCount += other.m_zeroCount;
+    for (const auto& [index, count] : other.m_buckets)
+    {
+        m_buckets[index] += count;
+    }
+}
+
+double
+QuantileSketch::GetQuantile(double q) const
+{
+    if (m_count == 0)
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    const double rank = q * (m_count - 1);
+    uint64_t cumulative = m_zeroCount;
+    if (rank < cumulative)
+    {
+        return 0;
+    }
+    // The bucket (gamma^(i-1), gamma^i] is represented by the point of
+    // equal relative error to both ends
+    const double gamma = std::exp(m_logGamma);
+    double value = 0;
+    for (const auto& [index, count] : m_buckets)
+    {
+        cumulative += count;
+        value = 2 * std::exp(index * m_logGamma) / (gamma + 1);
+        if (rank < cumulative)
+        {
+            break;
+        }
+    }
+    return value;
+}
+
+void
+MetricSummary::Add(double value)
+{
+    if (count == 0)
+    {
+        min = max = value;
+    }
+    count++;
+    mean += (value - mean) / count;
+    min = std::min(min, value);
+    max = std::max(max, value);
+    sketch.Add(value);
+}
+
+void
+MetricSummary::Merge(const MetricSummary& other)
+{
+    if (other.count == 0)
+    {
+        return;
+    }
+    if (count == 0)
+    {
+        min = other.min;
+        max = other.max;
+    }
+    mean = (mean * count + other.mean * other.count) / (count + other.count);
+    count += other.count;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    sketch.Merge(other.sketch);
+}
+
+TraceSummarizer::TraceSummarizer(std::string inputDir, std::string outputDir, uint32_t jobs)
+    : m_inputDir(inputDir),
+      m_outputDir(outputDir),
+      m_jobs(jobs > 0 ? jobs : 1),
+      m_percentiles({50, 90, 99})
+{
+}
+
+void
+TraceSummarizer::SetPercentiles(const std::vector<double>& percentiles)
+{
+    for (double percentile : percentiles)
+    {
+        NS_ABORT_MSG_UNLESS(percentile > 0 && percentile < 100,
+                            "Percentile " << percentile << " not in (0, 100)");
+    }
+    m_percentiles = percentiles;
+}
+
+void
+TraceSummarizer::SummarizeFile(const std::string& fileName, RunSummary& summary) const
+{
+    std::string flow;
+    std::string direction;
+    Classify(fileName, flow, direction);
+    const bool isWindow = direction == "cwnd";
+    auto getSeries = [&](const std::string& metric) -> MetricSummary* {
+        return &summary.series[SeriesKey(flow, direction, metric)];
+    };
+
+    if (std::filesystem::path(fileName).extension() == ".btr")
+    {
+        BinaryTraceReader reader(fileName);
+        const auto& columns = reader.GetColumns();
+        std::size_t column = columns.size() - 1;
+        for (std::size_t i = 0; i < columns.size(); i++)
+        {
+            if (columns[i].name == "new")
+            {
+                column = i;
+            }
+        }
+        MetricSummary* series = getSeries("cwnd");
+        while (reader.ReadBlock())
+        {
+            for (uint32_t row = 0; row < reader.GetNRows(); row++)
+            {
+                series->Add(reader.GetValue(column, row));
+            }
+        }
+        return;
+    }
+
+    std::vector<char> buffer(1 << 20);
+    std::ifstream file;
+    file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    file.open(fileName);
+    NS_ABORT_MSG_UNLESS(file.is_open(), "Cannot open " << fileName);
+
+    // Column index and series of every summarized column
+    std::vector<std::pair<std::size_t, MetricSummary*>> targets;
+    std::string line;
+    std::vector<const char*> fields;
+    bool pending = false;
+    if (std::getline(file, line))
+    {
+        SplitFields(line, fields);
+        double value;
+        if (!fields.empty() && ParseNumber(fields[0], value))
+        {
+            // No header: a window trace is time,old,new or time,new
+            NS_ABORT_MSG_UNLESS(isWindow, fileName << " has no header");
+            targets.emplace_back(fields.size() - 1, getSeries("cwnd"));
+            pending = true;
+        }
+        for (std::size_t i = 0; i < fields.size() && !pending; i++)
+        {
+            const std::string name = fields[i];
+            if (isWindow && name == "new")
+            {
+                targets.emplace_back(i, getSeries("cwnd"));
+            }
+            auto metric = STATISTICS_COLUMNS.find(name);
+            if (!isWindow && metric != STATISTICS_COLUMNS.end())
+            {
+                targets.emplace_back(i, getSeries(metric->second));
+            }
+        }
+    }
+
+    while (pending || std::getline(file, line))
+    {
+        if (!pending)
+        {
+            SplitFields(line, fields);
+        }
+        pending = false;
+        for (const auto& [column, series] : targets)
+        {
+            double value;
+            if (column < fields.size() && ParseNumber(fields[column], value) &&
+                std::isfinite(value))
+            {
+                series->Add(value);
+            }
+        }
+    }
+}
+
+TraceSummarizer::RunSummary
+TraceSummarizer::SummarizeRun(const std::string& run) const
+{
+    RunSummary summary;
+    summary.run = run;
+    std::set<std::string> files;
+    for (const auto& entry : std::filesystem::directory_iterator(m_inputDir + "/" + run))
+    {
+        std::string flow;
+        std::string direction;
+        if (entry.is_regular_file() && Classify(entry.path(), flow, direction))
+        {
+            files.insert(entry.path().string());
+        }
+    }
+    for (const auto& fileName : files)
+    {
+        SummarizeFile(fileName, summary);
+    }
+    return summary;
+}
+
+void
+TraceSummarizer::WriteRow(std::ostream& os,
+                          const std::string& prefix,
+                          const MetricSummary& summary) const
+{
+    os << prefix << summary.count << "," << summary.mean << "," << summary.min << ","
+       << summary.max;
+    for (double percentile : m_percentiles)
+    {
+        // Within the sketch accuracy, but never outside the observed range
+        const double quantile = summary.sketch.GetQuantile(percentile / 100);
+        os << "," << std::clamp(quantile, summary.min, summary.max);
+    }
+    os << "\n";
+}
+
+uint32_t
+TraceSummarizer::Run()
+{
+    // Only the run paths are kept, sorted so that the output is stable
+    std::set<std::string> runSet;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(m_inputDir))
+    {
+        std::string flow;
+        std::string direction;
+        if (entry.is_regular_file() && Classify(entry.path(), flow, direction))
+        {
+            const auto run = std::filesystem::relative(entry.path().parent_path(), m_inputDir);
+            runSet.insert(run.generic_string());
+        }
+    }
+    const std::vector<std::string> runs(runSet.begin(), runSet.end());
+    NS_LOG_INFO("Found " << runs.size() << " runs in " << m_inputDir);
+
+    std::filesystem::create_directories(m_outputDir);
+    std::ostringstream header;
+    header << "count,mean,min,max";
+    for (double percentile : m_percentiles)
+    {
+        header << ",p" << percentile;
+    }
+    std::ofstream runsCsv(m_outputDir + "/summary-runs.csv");
+    runsCsv << std::setprecision(10) << "run,flow,direction,metric," << header.str() << "\n";
+
+    using GroupKey = std::tuple<std::string, std::string, std::string, std::string>;
+    std::map<GroupKey, GroupSummary> groups;
+
+    // Runs are summarized a chunk at a time, so that only a chunk of run
+    // summaries is held at once
+    const std::size_t chunkSize = 4 * m_jobs;
+    for (std::size_t first = 0; first < runs.size(); first += chunkSize)
+    {
+        const std::size_t n = std::min(chunkSize, runs.size() - first);
+        std::vector<RunSummary> summaries(n);
+        std::atomic<std::size_t> next{0};
+        std::vector<std::thread> workers;
+        for (uint32_t j = 0; j < std::min<std::size_t>(m_jobs, n); j++)
+        {
+            workers.emplace_back([&]() {
+                for (std::size_t i = next++; i < n; i = next++)
+                {
+                    summaries[i] = SummarizeRun(runs[first + i]);
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+
+        for (const RunSummary& summary : summaries)
+        {
+            const std::string group = GetGroup(summary.run);
+            std::vector<double> throughputs;
+            for (const auto& [key, series] : summary.series)
+            {
+                const auto& [flow, direction, metric] = key;
+                WriteRow(runsCsv,
+                         summary.run + "," + flow + "," + direction + "," + metric + ",",
+                         series);
+                GroupSummary& groupSummary =
+                    groups[GroupKey(group, GetFlowClass(flow), direction, metric)];
+                groupSummary.runs++;
+                groupSummary.summary.Merge(series);
+                if (direction == "client" && metric == "kbps")
+                {
+                    throughputs.push_back(series.mean);
+                }
+            }
+            if (!throughputs.empty())
+            {
+                MetricSummary jain;
+                jain.Add(GetJainIndex(throughputs));
+                WriteRow(runsCsv, summary.run + ",all,client,jain,", jain);
+                GroupSummary& groupSummary = groups[GroupKey(group, "all", "client", "jain")];
+                groupSummary.runs++;
+                groupSummary.summary.Merge(jain);
+            }
+        }
+        NS_LOG_INFO("Summarized " << first + n << "/" << runs.size() << " runs");
+    }
+
+    std::ofstream groupsCsv(m_outputDir + "/summary-groups.csv");
+    groupsCsv << std::setprecision(10) << "group,flow,direction,metric,runs," << header.str()
+              << "\n";
+    for (const auto& [key, groupSummary] : groups)
+    {
+        const auto& [group, flow, direction, metric] = key;
+        WriteRow(groupsCsv,
+                 group + "," + flow + "," + direction + "," + metric + "," +
+                     std::to_string(groupSummary.runs) + ",",
+                 groupSummary.summary);
+    }
+    return runs.size();
+}
+
+} // namespace ns3
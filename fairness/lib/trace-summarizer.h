@@ -0,0 +1,168 @@
+#ifndef FAIRNESS_TRACE_SUMMARIZER_H
+#define FAIRNESS_TRACE_SUMMARIZER_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Mergeable quantile estimate of a stream of non-negative values.
+ *
+ * Values are counted in logarithmic buckets of relative width `accuracy`, so
+ * every quantile is within that relative error of an actual sample, and the
+ * memory depends on the range of the values rather than on their number.
+ * Values at or below zero share one bucket.
+ */
+class QuantileSketch
+{
+  public:
+    /**
+     * \param accuracy The relative accuracy of the quantiles.
+     */
+    QuantileSketch(double accuracy = 0.01);
+
+    /**
+     * \param value The value to add.
+     */
+    void Add(double value);
+
+    /**
+     * Add the values of another sketch of the same accuracy.
+     *
+     * \param other The other sketch.
+     */
+    void Merge(const QuantileSketch& other);
+
+    /**
+     * \param q The quantile, in [0, 1].
+     * \return The estimate, NaN if the sketch is empty.
+     */
+    double GetQuantile(double q) const;
+
+  private:
+    double m_logGamma;                 //!< Log of the bucket growth factor.
+    uint64_t m_count{0};               //!< Number of values.
+    uint64_t m_zeroCount{0};           //!< Number of values <= 0.
+    std::map<int, uint64_t> m_buckets; //!< Count per bucket index.
+};
+
+/**
+ * Count, mean, extremes and quantiles of a series, in bounded memory.
+ */
+struct MetricSummary
+{
+    uint64_t count{0};     //!< Number of values.
+    double mean{0};        //!< Mean.
+    double min{0};         //!< Minimum.
+    double max{0};         //!< Maximum.
+    QuantileSketch sketch; //!< Quantiles.
+
+    /**
+     * \param value The value to add.
+     */
+    void Add(double value);
+
+    /**
+     * \param other The summary to add.
+     */
+    void Merge(const MetricSummary& other);
+};
+
+/**
+ * Single-pass summary of the results of a sweep.
+ *
+ * Finds the per-step statistics (<flow>-client.csv, <flow>-server.csv,
+ * <flow>-metrics.csv) and the congestion window traces (*cwnd*.csv, .txt
+ * or .btr) below the input directory, and summarizes the throughput, loss,
+ * delay, jitter and cwnd of every flow of every run, where a run is a
+ * directory holding such files. The per-run Jain's fairness index is taken
+ * over the mean client throughput of the flows of the run.
+ *
+ * Runs are grouped by their path without the trailing run-<n> component,
+ * as laid out by SweepRunner, or else by their parent directory, and flows
+ * by their name without the trailing digits, e.g. tcp-flow. Every file is
+ * read once; runs are summarized in parallel, `jobs` at a time, and only the
+ * group summaries are kept across runs. Writes summary-runs.csv and
+ * summary-groups.csv.
+ */
+class TraceSummarizer
+{
+  public:
+    /**
+     * \param inputDir The sweep directory.
+     * \param outputDir The directory of the summary files.
+     * \param jobs Runs summarized in parallel.
+     */
+    TraceSummarizer(std::string inputDir, std::string outputDir, uint32_t jobs);
+
+    /**
+     * \param percentiles The percentiles to report, in (0, 100).
+     */
+    void SetPercentiles(const std::vector<double>& percentiles);
+
+    /**
+     * Summarize the sweep and write the summary files.
+     *
+     * \return The number of runs.
+     */
+    uint32_t Run();
+
+  private:
+    /// Flow name, direction and metric of a series.
+    using SeriesKey = std::tuple<std::string, std::string, std::string>;
+
+    /**
+     * The series of one run.
+     */
+    struct RunSummary
+    {
+        std::string run;                           //!< Run path.
+        std::map<SeriesKey, MetricSummary> series; //!< Series of the run.
+    };
+
+    /**
+     * A series of a group, over all its runs.
+     */
+    struct GroupSummary
+    {
+        uint32_t runs{0};      //!< Runs with the series.
+        MetricSummary summary; //!< Values of all the runs.
+    };
+
+    /**
+     * \param run A run path.
+     * \return The summary of the run.
+     */
+    RunSummary SummarizeRun(const std::string& run) const;
+
+    /**
+     * Add the series of a file to a run summary.
+     *
+     * \param fileName The file.
+     * \param summary The run summary.
+     */
+    void SummarizeFile(const std::string& fileName, RunSummary& summary) const;
+
+    /**
+     * Write one summary row.
+     *
+     * \param os The output stream.
+     * \param prefix The leading fields, with their trailing comma.
+     * \param summary The summary.
+     */
+    void WriteRow(std::ostream& os, const std::string& prefix, const MetricSummary& summary) const;
+
+    std::string m_inputDir;            //!< Sweep directory.
+    std::string m_outputDir;           //!< Directory of the summary files.
+    uint32_t m_jobs;                   //!< Runs summarized in parallel.
+    std::vector<double> m_percentiles; //!< Reported percentiles.
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_TRACE_SUMMARIZER_H */
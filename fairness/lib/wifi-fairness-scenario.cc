@@ -0,0 +1,650 @@
+#include "wifi-fairness-scenario.h"
+
+#include "cached-propagation-model.h"
+#include "culled-yans-wifi-channel.h"
+#include "event-profiler.h"
+#include "fairness-monitor.h"
+#include "node-statistics.h"
+#include "result-cache.h"
+#include "results-database.h"
+#include "run-manifest.h"
+#include "steady-state-monitor.h"
+#include "sweep-runner.h"
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/quic-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("WifiFairnessScenario");
+
+WifiFairnessScenario::WifiFairnessScenario(const ScenarioConfig& config)
+    : m_config(config)
+{
+    RngSeedManager::SetRun(m_config.run);
+
+    m_resultDir = m_config.outputDir;
+    m_runId = m_config.outputDir;
+    if (m_resultDir.empty())
+    {
+        m_runId = AllocateRunDirectory(".");
+        m_resultDir = "./" + m_runId;
+    }
+    m_outputDir = m_resultDir;
+
+    if (!m_config.cache.empty())
+    {
+        // Where the results go and where the cache is do not change them
+        ScenarioConfig keyConfig = m_config;
+        keyConfig.outputDir = "";
+        keyConfig.cache = "";
+        keyConfig.database = "";
+        std::ostringstream parameters;
+        keyConfig.Write(parameters);
+        m_cacheKey = ResultCache::ComputeKey(parameters.str());
+
+        ResultCache cache(m_config.cache);
+        m_cacheHit = cache.Contains(m_cacheKey);
+        if (m_cacheHit)
+        {
+            NS_LOG_INFO("Cache hit " << m_cacheKey << " for " << m_resultDir);
+            return;
+        }
+        m_outputDir = cache.Reserve(m_cacheKey);
+    }
+    std::filesystem::create_directories(m_outputDir);
+
+    if (!m_config.profile.empty())
+    {
+        EnableEventProfiler(m_outputDir + "/" + m_config.profile);
+    }
+
+    std::ofstream scenario(m_outputDir + "/scenario.ini");
+    m_config.Write(scenario);
+
+    std::ostringstream parameters;
+    m_config.Write(parameters);
+    m_manifest = new RunManifest(m_outputDir, m_runId);
+    m_manifest->SetParameters(parameters.str());
+}
+
+std::string
+WifiFairnessScenario::GetOutputDir() const
+{
+    return m_resultDir;
+}
+
+void
+WifiFairnessScenario::Build()
+{
+    if (m_cacheHit)
+    {
+        return;
+    }
+    CreateNodes();
+    InstallMobility();
+    InstallWifi();
+    InstallBackhaul();
+    InstallInternet();
+    ConfigureTransport();
+    InstallApplications();
+    if (!m_config.IsWarmStart())
+    {
+        // Installed per branch after the fork, so that every child writes
+        // its own files
+        InstallStatistics();
+    }
+}
+
+void
+WifiFairnessScenario::CreateNodes()
+{
+    m_tcpStas.Create(m_config.nTcp);
+    m_quicStas.Create(m_config.nQuic);
+    m_udpStas.Create(m_config.nUdp);
+    m_stas.Add(m_tcpStas);
+    m_stas.Add(m_quicStas);
+    m_stas.Add(m_udpStas);
+    m_ap.Create(1);
+    m_gw.Create(1);
+    m_tcpServer.Create(1);
+    m_quicServer.Create(1);
+    m_udpServer.Create(1);
+}
+
+void
+WifiFairnessScenario::InstallMobility()
+{
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0, 10, 0.0)); // AP
+    for (uint32_t i = 0; i < m_stas.GetN(); i++)
+    {
+        positionAlloc->Add(Vector(m_config.initPos, 10, 0.0)); // STA
+    }
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(m_ap);
+    mobility.Install(m_stas);
+}
+
+void
+WifiFairnessScenario::InstallWifi()
+{
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211n);
+
+    // The legacy scenarios configured the loss and delay models after creating
+    // the channel, so they ran with the helper defaults; those are the config
+    // defaults here too.
+    YansWifiChannelHelper wifiChannel;
+    wifiChannel.SetPropagationDelay(m_config.propagationDelay);
+    wifiChannel.AddPropagationLoss(m_config.propagationLoss);
+
+    CulledYansWifiPhyHelper wifiPhy;
+    Ptr<YansWifiChannel> channel;
+    if (m_config.cullChannel)
+    {
+        channel = wifiPhy.SetCulledChannel(wifiChannel);
+    }
+    else
+    {
+        channel = wifiChannel.Create();
+        wifiPhy.SetChannel(channel);
+    }
+    if (m_config.cachePropagation)
+    {
+        CachePropagationModels(channel);
+    }
+    wifiPhy.Set("ChannelSettings", StringValue("{0, 0, BAND_2_4GHZ, 0}"));
+    if (m_config.errorTable)
+    {
+        // Tables of the helper's default model; see [ns3::TabulatedErrorRateModel]
+        wifiPhy.SetErrorRateModel("ns3::TabulatedErrorRateModel");
+    }
+
+    WifiMacHelper wifiMac;
+    Ssid ssid = Ssid("AP");
+    wifiMac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+    m_staDevices = wifi.Install(wifiPhy, wifiMac, m_stas);
+    wifiMac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    m_apDevices = wifi.Install(wifiPhy, wifiMac, m_ap);
+}
+
+void
+WifiFairnessScenario::InstallBackhaul()
+{
+    m_p2pApGw.SetDeviceAttribute("DataRate", StringValue(m_config.p2pApGwDataRate));
+    m_p2pApGw.SetChannelAttribute("Delay", StringValue(m_config.p2pApGwDelay));
+    m_apToGw = m_p2pApGw.Install(m_ap.Get(0), m_gw.Get(0));
+
+    PointToPointHelper p2pGwServer;
+    p2pGwServer.SetDeviceAttribute("DataRate", StringValue(m_config.p2pGwServerDataRate));
+    p2pGwServer.SetChannelAttribute("Delay", StringValue(m_config.p2pGwServerDelay));
+    m_gwToTcp = p2pGwServer.Install(m_gw.Get(0), m_tcpServer.Get(0));
+    m_gwToQuic = p2pGwServer.Install(m_gw.Get(0), m_quicServer.Get(0));
+    m_gwToUdp = p2pGwServer.Install(m_gw.Get(0), m_udpServer.Get(0));
+
+    m_errorModel = CreateObject<RateErrorModel>();
+    m_errorModel->SetAttribute("ErrorRate", DoubleValue(m_config.errorRate));
+    m_errorModel->SetAttribute("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
+    m_apToGw.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(m_errorModel));
+}
+
+void
+WifiFairnessScenario::InstallInternet()
+{
+    InternetStackHelper stack;
+    stack.Install(m_tcpStas);
+    stack.Install(m_udpStas);
+    stack.Install(m_ap);
+    stack.Install(m_gw);
+    stack.Install(m_tcpServer);
+    stack.Install(m_udpServer);
+    QuicHelper quic;
+    quic.InstallQuic(m_quicStas);
+    quic.InstallQuic(m_quicServer);
+
+    Ipv4AddressHelper address;
+    // STA & AP: a /16 from 10.0.1.1, so up to 254 STAs keep the legacy
+    // addresses and the benchmark sizes still fit
+    address.SetBase("10.0.0.0", "255.255.0.0", "0.0.1.1");
+    m_staIf = address.Assign(m_staDevices);
+    address.Assign(m_apDevices);
+    address.SetBase("10.1.2.0", "255.255.255.0"); // AP to GW
+    address.Assign(m_apToGw);
+    address.SetBase("10.2.3.0", "255.255.255.0"); // GW to TCP
+    m_gwTcpIf = address.Assign(m_gwToTcp);
+    address.SetBase("10.2.4.0", "255.255.255.0"); // GW to QUIC
+    m_gwQuicIf = address.Assign(m_gwToQuic);
+    address.SetBase("10.2.5.0", "255.255.255.0"); // GW to UDP
+    m_gwUdpIf = address.Assign(m_gwToUdp);
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+}
+
+void
+WifiFairnessScenario::ConfigureTransport()
+{
+    // Set after the stacks are installed, as in the legacy scenarios, so that
+    // results stay comparable: the L4 SocketType/RecoveryType defaults only
+    // apply to protocols created from here on.
+    TypeId transport = TypeId::LookupByName(m_config.transport_prot);
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", TypeIdValue(transport));
+    Config::SetDefault("ns3::TcpSocket::InitialCwnd", UintegerValue(1));
+    Config::SetDefault("ns3::TcpL4Protocol::RecoveryType",
+                       TypeIdValue(TypeId::LookupByName("ns3::TcpClassicRecovery")));
+    Config::SetDefault("ns3::QuicL4Protocol::SocketType", TypeIdValue(transport));
+    Config::SetDefault("ns3::QuicL4Protocol::0RTT-Handshake", BooleanValue(true));
+    Config::SetDefault("ns3::QuicSocketBase::InitialVersion",
+                       UintegerValue(QUIC_VERSION_NS3_IMPL));
+
+    Config::SetDefault("ns3::QuicSocketBase::SocketRcvBufSize", UintegerValue(1 << 21));
+    Config::SetDefault("ns3::QuicSocketBase::SocketSndBufSize", UintegerValue(1 << 21));
+    Config::SetDefault("ns3::QuicStreamBase::StreamSndBufSize", UintegerValue(1 << 21));
+    Config::SetDefault("ns3::QuicStreamBase::StreamRcvBufSize", UintegerValue(1 << 21));
+
+    Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(1 << 21));
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(1 << 21));
+    Config::SetDefault("ns3::TcpSocketBase::Sack", BooleanValue(true));
+}
+
+void
+WifiFairnessScenario::InstallApplications()
+{
+    const uint32_t nTcp = m_tcpStas.GetN();
+    const uint32_t nQuic = m_quicStas.GetN();
+    InstallProtocol("ns3::TcpSocketFactory",
+                    m_tcpStas,
+                    m_tcpServer.Get(0),
+                    m_gwTcpIf.GetAddress(1),
+                    0,
+                    m_config.tcpStart);
+    InstallProtocol("ns3::QuicSocketFactory",
+                    m_quicStas,
+                    m_quicServer.Get(0),
+                    m_gwQuicIf.GetAddress(1),
+                    nTcp,
+                    m_config.quicStart);
+    InstallProtocol("ns3::UdpSocketFactory",
+                    m_udpStas,
+                    m_udpServer.Get(0),
+                    m_gwUdpIf.GetAddress(1),
+                    nTcp + nQuic,
+                    m_config.udpStart);
+}
+
+void
+WifiFairnessScenario::InstallProtocol(const std::string& factory,
+                                      NodeContainer stas,
+                                      Ptr<Node> server,
+                                      Ipv4Address serverAddress,
+                                      uint32_t staOffset,
+                                      double start)
+{
+    if (stas.GetN() == 0)
+    {
+        return;
+    }
+    const uint16_t port = m_config.port;
+
+    ApplicationContainer clients;
+    ApplicationContainer servers;
+    if (m_config.IsUpstream())
+    {
+        ApplicationContainer sources =
+            InstallSource(factory,
+                          InetSocketAddress(serverAddress /*target: server address*/, port),
+                          stas,
+                          m_config.onOffUpRate);
+        m_upSources.Add(sources);
+        clients.Add(sources);
+        PacketSinkHelper sinkUp(factory, InetSocketAddress(serverAddress /*target: server address*/, port));
+        servers.Add(sinkUp.Install(server));
+    }
+    if (m_config.IsDownstream())
+    {
+        for (uint32_t i = 0; i < stas.GetN(); i++)
+        {
+            Ipv4Address staAddress = m_staIf.GetAddress(staOffset + i);
+            ApplicationContainer sources =
+                InstallSource(factory,
+                              InetSocketAddress(staAddress /*target: client address*/, port),
+                              NodeContainer(server),
+                              m_config.onOffDownRate);
+            m_downSources.Add(sources);
+            servers.Add(sources);
+            PacketSinkHelper sinkDown(factory, InetSocketAddress(staAddress /*target: client address*/, port));
+            clients.Add(sinkDown.Install(stas.Get(i)));
+        }
+    }
+
+    const int simuTime = m_config.GetSimuTime();
+    servers.Start(Seconds(start));
+    clients.Start(Seconds(start));
+    servers.Stop(Seconds(simuTime));
+    clients.Stop(Seconds(simuTime));
+}
+
+ApplicationContainer
+WifiFairnessScenario::InstallSource(const std::string& factory,
+                                    Address remote,
+                                    NodeContainer nodes,
+                                    const std::string& rate)
+{
+    if (m_config.application == "bulksend")
+    {
+        BulkSendHelper bulkSend(factory, remote);
+        bulkSend.SetAttribute("MaxBytes", UintegerValue(m_config.bsMaxByte));
+        return bulkSend.Install(nodes);
+    }
+    OnOffHelper onoff(factory, remote);
+    // Always on, as the legacy mains, unless a scenario sets the times
+    onoff.SetConstantRate(DataRate(rate), m_config.onOffPktSize);
+    if (!m_config.ofOnTime.empty())
+    {
+        onoff.SetAttribute(
+            "OnTime",
+            StringValue("ns3::ConstantRandomVariable[Constant=" + m_config.ofOnTime + "]"));
+    }
+    if (!m_config.ofOffTime.empty())
+    {
+        onoff.SetAttribute(
+            "OffTime",
+            StringValue("ns3::ConstantRandomVariable[Constant=" + m_config.ofOffTime + "]"));
+    }
+    return onoff.Install(nodes);
+}
+
+void
+WifiFairnessScenario::InstallStatistics()
+{
+    // Resolution of the per-step delay and jitter percentiles
+    Config::SetDefault("ns3::FlowMonitor::DelayBinWidth", DoubleValue(m_config.delayBinWidth));
+    Config::SetDefault("ns3::FlowMonitor::JitterBinWidth", DoubleValue(m_config.jitterBinWidth));
+
+    if (m_config.steadyWindow > 0)
+    {
+        // Only consider full steps after the last protocol started
+        double lastStart = 0;
+        lastStart = std::max(lastStart, m_tcpStas.GetN() > 0 ? m_config.tcpStart : 0);
+        lastStart = std::max(lastStart, m_quicStas.GetN() > 0 ? m_config.quicStart : 0);
+        lastStart = std::max(lastStart, m_udpStas.GetN() > 0 ? m_config.udpStart : 0);
+        m_steadyState = new SteadyStateMonitor(m_config.steadyWindow,
+                                               m_config.steadyTolerance,
+                                               Seconds(lastStart + m_config.stepsTime));
+    }
+    std::vector<std::string> protocols;
+    for (const auto& [protocol, stas] : {std::make_pair("tcp", m_tcpStas),
+                                         std::make_pair("quic", m_quicStas),
+                                         std::make_pair("udp", m_udpStas)})
+    {
+        if (stas.GetN() > 0)
+        {
+            protocols.push_back(protocol);
+        }
+    }
+    m_fairness = new FairnessMonitor(m_outputDir + "/fairness.csv", protocols);
+    if (!m_config.database.empty())
+    {
+        // Opened here rather than in the constructor, so that warm start
+        // branches do not share a connection across the fork
+        std::ostringstream parameters;
+        m_config.Write(parameters);
+        m_database = new ResultsDatabase(m_config.database, m_runId, parameters.str());
+    }
+    InstallProtocolStatistics(m_tcpStas, m_tcpServer.Get(0), "tcp-flow");
+    InstallProtocolStatistics(m_quicStas, m_quicServer.Get(0), "quic-flow");
+    InstallProtocolStatistics(m_udpStas, m_udpServer.Get(0), "udp-flow");
+
+    if (m_config.pcap)
+    {
+        m_p2pApGw.EnablePcap(m_outputDir + "/apToGw", m_apToGw);
+    }
+}
+
+void
+WifiFairnessScenario::InstallProtocolStatistics(NodeContainer stas,
+                                                Ptr<Node> server,
+                                                const std::string& name)
+{
+    for (uint32_t i = 0; i < stas.GetN(); i++)
+    {
+        NodeStatistics* nodeStat = new NodeStatistics(NodeContainer(stas.Get(i), server),
+                                                      m_outputDir + "/" + name + std::to_string(i),
+                                                      m_config.isDoubleStream);
+        nodeStat->steadyState = m_steadyState;
+        nodeStat->fairness = m_fairness;
+        nodeStat->database = m_database;
+        nodeStat->protocol = name.substr(0, name.find('-'));
+        m_statistics.push_back(nodeStat);
+        Simulator::Schedule(Seconds(0.5 + m_config.stepsTime) - Simulator::Now(),
+                            &NodeStatistics::AdvancePosition,
+                            nodeStat,
+                            stas.Get(i),
+                            m_config.stepsSize,
+                            m_config.stepsTime);
+        Config::Connect("/NodeList/" + std::to_string(stas.Get(i)->GetId()) +
+                            "/DeviceList/*/$ns3::WifiNetDevice/Phy/MonitorSnifferRx",
+                        MakeCallback(&NodeStatistics::MonitorSnifferRxCallback, nodeStat));
+    }
+}
+
+void
+WifiFairnessScenario::Run()
+{
+    if (m_cacheHit)
+    {
+        RestoreResult();
+        return;
+    }
+    if (m_config.IsWarmStart())
+    {
+        RunBranches();
+    }
+    else
+    {
+        Simulator::Stop(Seconds(m_config.GetSimuTime()));
+        Simulator::Run();
+        Finish();
+    }
+    StoreResult();
+}
+
+void
+WifiFairnessScenario::Finish()
+{
+    for (NodeStatistics* nodeStat : m_statistics)
+    {
+        nodeStat->WriteTotals();
+    }
+    if (m_steadyState != nullptr)
+    {
+        m_steadyState->WriteSummary(m_outputDir + "/steady-state.ini");
+    }
+    delete m_database;
+    m_database = nullptr;
+    delete m_fairness;
+    m_fairness = nullptr;
+    m_manifest->Finish(0);
+    Simulator::Destroy();
+}
+
+void
+WifiFairnessScenario::StoreResult()
+{
+    if (m_cacheKey.empty())
+    {
+        return;
+    }
+    ResultCache cache(m_config.cache);
+    cache.Commit(m_cacheKey, m_outputDir);
+    cache.Restore(m_cacheKey, m_resultDir);
+    m_outputDir = m_resultDir;
+}
+
+void
+WifiFairnessScenario::RestoreResult()
+{
+    ResultCache(m_config.cache).Restore(m_cacheKey, m_resultDir);
+    std::vector<std::pair<ScenarioConfig, std::string>> runs = {{m_config, ""}};
+    if (m_config.IsWarmStart())
+    {
+        for (const auto& value : SplitList(m_config.branchValues))
+        {
+            ScenarioConfig config = m_config;
+            config.Set(config.branch, value);
+            runs.emplace_back(config, "/" + config.branch + "-" + value);
+        }
+    }
+    for (const auto& [config, branchDir] : runs)
+    {
+        const std::string runDir = m_resultDir + branchDir;
+        std::ofstream scenario(runDir + "/scenario.ini");
+        config.Write(scenario);
+        scenario.close();
+
+        std::ostringstream parameters;
+        config.Write(parameters);
+        RunManifest manifest(runDir, m_runId + branchDir);
+        manifest.SetParameters(parameters.str());
+        manifest.SetCacheHit(m_cacheKey);
+        manifest.Finish(0);
+
+        // The metrics go to the database under this run id, from the cached
+        // CSV files; the warm start prefix has none of its own
+        if (config.database.empty() || (config.IsWarmStart() && branchDir.empty()))
+        {
+            continue;
+        }
+        std::vector<std::string> files;
+        for (const auto& entry : std::filesystem::directory_iterator(runDir))
+        {
+            const std::string name = entry.path().filename().string();
+            const std::size_t dash = name.rfind('-');
+            if (dash != std::string::npos &&
+                (name.substr(dash) == "-client.csv" || name.substr(dash) == "-server.csv"))
+            {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        ResultsDatabase database(config.database, m_runId + branchDir, parameters.str());
+        for (const auto& file : files)
+        {
+            database.InsertCsv(file);
+        }
+    }
+}
+
+void
+WifiFairnessScenario::RunBranches()
+{
+    const std::string& branch = m_config.branch;
+    NS_ABORT_MSG_UNLESS(branch == "initPos" || branch == "errorRate" || branch == "onOffUpRate" ||
+                            branch == "onOffDownRate",
+                        "Cannot branch on " << branch);
+    // The first step samples the flows, so the statistics must exist by then
+    NS_ABORT_MSG_UNLESS(m_config.forkTime > 0 && m_config.forkTime < 0.5 + m_config.stepsTime,
+                        "forkTime must be in (0, " << 0.5 + m_config.stepsTime << ")");
+
+    Simulator::Stop(Seconds(m_config.forkTime));
+    Simulator::Run();
+    NS_LOG_INFO("Warm start prefix done at " << Simulator::Now().As(Time::S));
+
+    const uint32_t jobs = std::max(std::thread::hardware_concurrency(), 1U);
+    uint32_t running = 0;
+    uint32_t failed = 0;
+    auto reap = [&running, &failed]() {
+        int status = 0;
+        if (wait(&status) > 0)
+        {
+            running--;
+            failed += !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+        }
+    };
+    std::cout.flush();
+    for (const auto& value : SplitList(m_config.branchValues))
+    {
+        if (running == jobs)
+        {
+            reap();
+        }
+        pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "fork failed for " << branch << "=" << value);
+        if (pid == 0)
+        {
+            RunBranch(value);
+        }
+        running++;
+    }
+    while (running > 0)
+    {
+        reap();
+    }
+    m_manifest->Finish(failed > 0 ? 1 : 0);
+    NS_ABORT_MSG_IF(failed > 0, failed << " warm start branches failed");
+    Simulator::Destroy();
+}
+
+void
+WifiFairnessScenario::RunBranch(const std::string& value)
+{
+    m_config.Set(m_config.branch, value);
+    m_outputDir += "/" + m_config.branch + "-" + value;
+    std::filesystem::create_directories(m_outputDir);
+    if (!m_config.profile.empty())
+    {
+        // The prefix process keeps the report path it was enabled with
+        SetEventProfilerReport(m_outputDir + "/" + m_config.profile);
+    }
+    std::ofstream scenario(m_outputDir + "/scenario.ini");
+    m_config.Write(scenario);
+    scenario.close();
+
+    std::ostringstream parameters;
+    m_config.Write(parameters);
+    m_runId += "/" + m_config.branch + "-" + value;
+    m_manifest = new RunManifest(m_outputDir, m_runId);
+    m_manifest->SetParameters(parameters.str());
+
+    for (uint32_t i = 0; i < m_stas.GetN(); i++)
+    {
+        Ptr<MobilityModel> mobility = m_stas.Get(i)->GetObject<MobilityModel>();
+        mobility->SetPosition(Vector(m_config.initPos, 10, 0.0));
+    }
+    m_errorModel->SetAttribute("ErrorRate", DoubleValue(m_config.errorRate));
+    if (m_config.application == "onoff")
+    {
+        for (uint32_t i = 0; i < m_upSources.GetN(); i++)
+        {
+            m_upSources.Get(i)->SetAttribute("DataRate", StringValue(m_config.onOffUpRate));
+        }
+        for (uint32_t i = 0; i < m_downSources.GetN(); i++)
+        {
+            m_downSources.Get(i)->SetAttribute("DataRate", StringValue(m_config.onOffDownRate));
+        }
+    }
+    InstallStatistics();
+
+    Simulator::Stop(Seconds(m_config.GetSimuTime()) - Simulator::Now());
+    Simulator::Run();
+    Finish();
+    std::cout.flush();
+    _exit(0);
+}
+
+} // namespace ns3
@@ -0,0 +1,207 @@
+#ifndef FAIRNESS_WIFI_FAIRNESS_SCENARIO_H
+#define FAIRNESS_WIFI_FAIRNESS_SCENARIO_H
+
+#include "scenario-config.h"
+
+#include "ns3/applications-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class FairnessMonitor;
+class NodeStatistics;
+class ResultsDatabase;
+class RunManifest;
+class SteadyStateMonitor;
+
+/**
+ * The single-AP WiFi fairness topology of the base-of.cc family.
+ *
+ * TCP, QUIC and UDP STAs share one 802.11n AP, which is connected through a
+ * gateway to one server per protocol:
+ *
+ *   STAs ~~~ AP --- GW --- TCP server
+ *                     |--- QUIC server
+ *                     `--- UDP server
+ *
+ * Nodes are created STAs first (TCP, QUIC, UDP), then AP, GW and the servers,
+ * so node ids match the legacy scenarios.
+ *
+ * Without an outputDir, the run gets a new directory from
+ * AllocateRunDirectory(), so concurrent runs never share one. Every run
+ * writes a manifest.ini and the per-step fairness series, fairness.csv, next
+ * to its results and, with database set, its per-step metrics to that shared
+ * SQLite file under the run id.
+ *
+ * With branchValues set, the run is a warm start: the association, ARP and
+ * handshake prefix up to forkTime is simulated once, then the process forks
+ * one child per branch value. Each child sets the branch parameter, which
+ * must be one of initPos, errorRate, onOffUpRate or onOffDownRate, installs
+ * the statistics and runs to the end in <outputDir>/<branch>-<value>.
+ *
+ * With cache set, the run is looked up in a ResultCache first. On a hit,
+ * Build() does nothing and Run() copies the cached results to the output
+ * directory; on a miss the run writes to a private cache directory that is
+ * stored and then copied to the output directory once it is complete. The
+ * database of a hit gets the metrics of the cached -client.csv and
+ * -server.csv files, at their printed precision.
+ */
+class WifiFairnessScenario
+{
+  public:
+    /**
+     * \param config The scenario parameters.
+     */
+    WifiFairnessScenario(const ScenarioConfig& config);
+
+    /**
+     * Create the topology, the applications and the statistics.
+     */
+    void Build();
+
+    /**
+     * Run the simulation, or all its branches for a warm start, and tear it
+     * down.
+     */
+    void Run();
+
+    /**
+     * \return The directory the run writes its results to.
+     */
+    std::string GetOutputDir() const;
+
+  private:
+    /// Create the STA, AP, GW and server nodes.
+    void CreateNodes();
+    /// Place the AP and the STAs.
+    void InstallMobility();
+    /// Install the WiFi devices of the STAs and the AP.
+    void InstallWifi();
+    /// Install the point-to-point AP-GW and GW-server links.
+    void InstallBackhaul();
+    /// Install the internet stacks and assign addresses.
+    void InstallInternet();
+    /// Set the TCP and QUIC socket defaults.
+    void ConfigureTransport();
+    /// Install the on/off sources and packet sinks of every protocol.
+    void InstallApplications();
+    /// Create the per-STA statistics, the fairness and steady state monitors
+    /// and the database.
+    void InstallStatistics();
+    /// Write the end-of-run results and tear the simulation down.
+    void Finish();
+    /// Store the results in the cache, if enabled, and copy them out.
+    void StoreResult();
+
+    /**
+     * Install the applications of one protocol.
+     *
+     * \param factory The socket factory TypeId name.
+     * \param stas The STAs of the protocol.
+     * \param server The server of the protocol.
+     * \param serverAddress The server address.
+     * \param staOffset Index of the first STA of the protocol in m_staIf.
+     * \param start The start time of the applications (s).
+     */
+    void InstallProtocol(const std::string& factory,
+                         NodeContainer stas,
+                         Ptr<Node> server,
+                         Ipv4Address serverAddress,
+                         uint32_t staOffset,
+                         double start);
+
+    /**
+     * Install the traffic source selected by the application parameter.
+     *
+     * \param factory The socket factory TypeId name.
+     * \param remote The destination address.
+     * \param nodes The nodes to install the source on.
+     * \param rate The on/off data rate.
+     * \return The installed applications.
+     */
+    ApplicationContainer InstallSource(const std::string& factory,
+                                       Address remote,
+                                       NodeContainer nodes,
+                                       const std::string& rate);
+
+    /**
+     * Copy the cached results of the run to the result directory, with the
+     * manifest and scenario.ini of this run instead of those of the run
+     * that stored the entry, and with database set, insert the cached
+     * per-step metrics under the run id of this run.
+     */
+    void RestoreResult();
+
+    /**
+     * Run the shared prefix, then fork a child per branch value, at most one
+     * per core at a time.
+     */
+    void RunBranches();
+
+    /**
+     * Apply a branch value and run the rest of the simulation. Runs in the
+     * child process and does not return.
+     *
+     * \param value The value of the branch parameter.
+     */
+    [[noreturn]] void RunBranch(const std::string& value);
+
+    /**
+     * Create the statistics of the STAs of one protocol.
+     *
+     * \param stas The STAs of the protocol.
+     * \param server The server of the protocol.
+     * \param name The file name prefix of the protocol.
+     */
+    void InstallProtocolStatistics(NodeContainer stas, Ptr<Node> server, const std::string& name);
+
+    ScenarioConfig m_config; //!< Scenario parameters.
+    std::string m_outputDir; //!< Directory the simulation writes to.
+    std::string m_resultDir; //!< Result directory.
+    std::string m_cacheKey;  //!< Result cache key, empty if the cache is off.
+    bool m_cacheHit{false};  //!< Whether the results are already cached.
+    std::string m_runId;     //!< Run id of the manifest.
+
+    NodeContainer m_tcpStas;  //!< TCP STAs.
+    NodeContainer m_quicStas; //!< QUIC STAs.
+    NodeContainer m_udpStas;  //!< UDP STAs.
+    NodeContainer m_stas;     //!< All STAs, TCP first, then QUIC, then UDP.
+    NodeContainer m_ap;       //!< The AP.
+    NodeContainer m_gw;       //!< The gateway.
+    NodeContainer m_tcpServer;//!< The TCP server.
+    NodeContainer m_quicServer; //!< The QUIC server.
+    NodeContainer m_udpServer;//!< The UDP server.
+
+    NetDeviceContainer m_staDevices;  //!< STA WiFi devices.
+    NetDeviceContainer m_apDevices;   //!< AP WiFi device.
+    NetDeviceContainer m_apToGw;      //!< AP-GW link devices.
+    NetDeviceContainer m_gwToTcp;     //!< GW-TCP server link devices.
+    NetDeviceContainer m_gwToQuic;    //!< GW-QUIC server link devices.
+    NetDeviceContainer m_gwToUdp;     //!< GW-UDP server link devices.
+    PointToPointHelper m_p2pApGw;     //!< AP-GW link helper, kept for pcap.
+    Ptr<RateErrorModel> m_errorModel; //!< AP-GW receive error model.
+
+    Ipv4InterfaceContainer m_staIf;     //!< STA interfaces.
+    Ipv4InterfaceContainer m_gwTcpIf;   //!< GW-TCP server interfaces.
+    Ipv4InterfaceContainer m_gwQuicIf;  //!< GW-QUIC server interfaces.
+    Ipv4InterfaceContainer m_gwUdpIf;   //!< GW-UDP server interfaces.
+
+    ApplicationContainer m_upSources; //!< Traffic sources on the STAs.
+    ApplicationContainer m_downSources; //!< Traffic sources on the servers.
+
+    std::vector<NodeStatistics*> m_statistics;  //!< Per-STA statistics.
+    SteadyStateMonitor* m_steadyState{nullptr}; //!< Early stop, if enabled.
+    FairnessMonitor* m_fairness{nullptr};       //!< Per-step fairness series.
+    RunManifest* m_manifest{nullptr};           //!< Manifest of the run.
+    ResultsDatabase* m_database{nullptr};       //!< Results database, if enabled.
+};
+
+} // namespace ns3
+
+#endif /* FAIRNESS_WIFI_FAIRNESS_SCENARIO_H */
@@ -23,8 +23,16 @@
 #include "ns3/yans-wifi-channel.h"
 #include "ns3/yans-wifi-helper.h"
 
-#include <ctime>
-#include <filesystem>
+#include "../fairness/lib/buffered-trace-sink.h"
+#include "../fairness/lib/cached-propagation-model.h"
+#include "../fairness/lib/culled-yans-wifi-channel.h"
+#include "../fairness/lib/event-profiler.h"
+#include "../fairness/lib/fairness-monitor.h"
+#include "../fairness/lib/flow-group-monitor.h"
+#include "../fairness/lib/run-manifest.h"
+#include "../fairness/lib/steady-state-monitor.h"
+
+#include <cmath>
 #include <iostream>
 
 using namespace ns3;
@@ -36,43 +44,49 @@ class NodeStatistics{
   public:
     std::string flowName;
     int stepItr = 0;
-    FlowMonitorHelper fh;
-    Ptr<FlowMonitor> monitor;
+    FlowGroupMonitor* flows;
+    uint32_t flowGroup;
+    Ipv4Address server;
+    SteadyStateMonitor* steadyState = nullptr;
+    FairnessMonitor* fairness = nullptr;
+    std::string protocol;
     AsciiTraceHelper asciiHelper;
-    NodeContainer nodes;
     std::string tcpNodes[4] = {"0", "1", "5", "6"};
     std::string quicNodes[4] = {"2", "3", "7", "8"};
 
     Ptr<OutputStreamWrapper> metricsCsv;
     Ptr<OutputStreamWrapper> cwndCsv;
-    std::map<std::string,Ptr<OutputStreamWrapper>> nodeCwnd;
-    std::map<std::string,Ptr<OutputStreamWrapper>> nodeSsth;
-    std::map<std::string,Ptr<OutputStreamWrapper>> nodeHandshake;
+    std::map<std::string,Ptr<BufferedTraceSink>> nodeCwnd;
+    std::map<std::string,Ptr<BufferedTraceSink>> nodeSsth;
+    std::map<std::string,Ptr<BufferedTraceSink>> nodeHandshake;
 
 
-    NodeStatistics(NodeContainer nodes, std::string flowName, int tcpOrQuicOrUdp);
+    NodeStatistics(FlowGroupMonitor* flows, Ipv4Address server, std::string flowName, int tcpOrQuicOrUdp);
     void Metrics();
-    std::string GetNodeIdFromContext(std::string context);
-    void CwndTracer(std::string context, uint32_t oldval, uint32_t newval);
-    void SsThTracer(std::string context, uint32_t oldval, uint32_t newval);
-    void TcpHandshakeTracer(std::string context, const TcpSocket::TcpStates_t oldState, const TcpSocket::TcpStates_t newState);
-    void QuicHandshakeTracer(std::string context,  const QuicSocket::QuicStates_t oldState, const QuicSocket::QuicStates_t newState);
+    void WriteTotals();
+    static void CwndTracer(Ptr<BufferedTraceSink> stream, uint32_t oldval, uint32_t newval);
+    static void SsThTracer(Ptr<BufferedTraceSink> stream, uint32_t oldval, uint32_t newval);
+    static void TcpHandshakeTracer(Ptr<BufferedTraceSink> stream, const TcpSocket::TcpStates_t oldState, const TcpSocket::TcpStates_t newState);
+    static void QuicHandshakeTracer(Ptr<BufferedTraceSink> stream, const QuicSocket::QuicStates_t oldState, const QuicSocket::QuicStates_t newState);
     void RegisterTcpCwnd(std::string node);
     void RegisterQuicCwnd(std::string node);
     void AdvancePosition(int stepsTime);
-    std::string TcpStateToString(TcpSocket::TcpStates_t state);
-    std::string QuicStateToString(QuicSocket::QuicStates_t state);
+    static std::string TcpStateToString(TcpSocket::TcpStates_t state);
+    static std::string QuicStateToString(QuicSocket::QuicStates_t state);
 
 };
 
-NodeStatistics::NodeStatistics(NodeContainer nodes, std::string flowName, int tcpOrQuicOrUdp): fh(), asciiHelper(){
-    this->nodes = nodes;
+NodeStatistics::NodeStatistics(FlowGroupMonitor* flows, Ipv4Address server, std::string flowName, int tcpOrQuicOrUdp): asciiHelper(){
+    this->flows = flows;
+    this->flowGroup = flows->AddGroup(server);
+    this->server = server;
     this->flowName = flowName;
-    monitor = fh.Install(this->nodes);
+    const std::string protocols[3] = {"TCP", "QUIC", "UDP"};
+    this->protocol = protocols[tcpOrQuicOrUdp];
 
     std::ostringstream metrics; metrics << flowName << "-metrics.csv";
     metricsCsv = asciiHelper.CreateFileStream(metrics.str().c_str());
-    *metricsCsv->GetStream() << "step,kbps,jtr,plr,del,sen,rcv,source" << std::endl;
+    *metricsCsv->GetStream() << "step,kbps,jtr,plr,del,sen,rcv,source,del_p50,del_p90,del_p99,jtr_p50,jtr_p90,jtr_p99" << std::endl;
 
 
         for(int i = 0; i <4; i++){
@@ -89,18 +103,18 @@ NodeStatistics::NodeStatistics(NodeContainer nodes, std::string flowName, int tc
             {
                 std::ostringstream cwnd;
                 cwnd << flowName << "-node" << node << "-cwnd.csv";
-                nodeCwnd[node] = asciiHelper.CreateFileStream(cwnd.str().c_str());
-                *nodeCwnd[node]->GetStream() << "time,old,new" << std::endl;
+                nodeCwnd[node] = CreateBufferedTraceSink(cwnd.str());
+                *nodeCwnd[node]->GetStream() << "time,old,new\n";
 
                 std::ostringstream ssth;
                 ssth << flowName << "-node" << node << "-ssth.csv";
-                nodeSsth[node] = asciiHelper.CreateFileStream(ssth.str().c_str());
-                *nodeSsth[node]->GetStream() << "time,old,new" << std::endl;
+                nodeSsth[node] = CreateBufferedTraceSink(ssth.str());
+                *nodeSsth[node]->GetStream() << "time,old,new\n";
 
                 std::ostringstream handshake;
                 handshake << flowName << "-node" << node << "-handshake.csv";
-                nodeHandshake[node] = asciiHelper.CreateFileStream(handshake.str().c_str());
-                *nodeHandshake[node]->GetStream() << "time,old,new" << std::endl;
+                nodeHandshake[node] = CreateBufferedTraceSink(handshake.str());
+                *nodeHandshake[node]->GetStream() << "time,old,new\n";
             }
         }
 
@@ -109,16 +123,18 @@ NodeStatistics::NodeStatistics(NodeContainer nodes, std::string flowName, int tc
 
 }
 
+// The node's streams are bound into the callbacks, so the tracers need neither
+// the context string nor a map lookup per event
 void NodeStatistics::RegisterTcpCwnd(std::string node){
-    Config::Connect("/NodeList/"+(node)+"/$ns3::TcpL4Protocol/SocketList/0/CongestionWindow", MakeCallback (&NodeStatistics::CwndTracer, this));
-    Config::Connect("/NodeList/"+(node)+"/$ns3::TcpL4Protocol/SocketList/0/SlowStartThreshold", MakeCallback (&NodeStatistics::SsThTracer, this));
-    Config::Connect("/NodeList/"+(node)+"/$ns3::TcpL4Protocol/SocketList/0/State", MakeCallback (&NodeStatistics::TcpHandshakeTracer, this));
+    Config::ConnectWithoutContext("/NodeList/"+(node)+"/$ns3::TcpL4Protocol/SocketList/0/CongestionWindow", MakeBoundCallback (&NodeStatistics::CwndTracer, nodeCwnd[node]));
+    Config::ConnectWithoutContext("/NodeList/"+(node)+"/$ns3::TcpL4Protocol/SocketList/0/SlowStartThreshold", MakeBoundCallback (&NodeStatistics::SsThTracer, nodeSsth[node]));
+    Config::ConnectWithoutContext("/NodeList/"+(node)+"/$ns3::TcpL4Protocol/SocketList/0/State", MakeBoundCallback (&NodeStatistics::TcpHandshakeTracer, nodeHandshake[node]));
 }
 
 void NodeStatistics::RegisterQuicCwnd(std::string node){
-    Config::Connect ("/NodeList/"+(node)+"/$ns3::QuicL4Protocol/SocketList/0/QuicSocketBase/CongestionWindow", MakeCallback (&NodeStatistics::CwndTracer, this));
-    Config::Connect ("/NodeList/"+(node)+"/$ns3::QuicL4Protocol/SocketList/0/QuicSocketBase/SlowStartThreshold", MakeCallback (&NodeStatistics::SsThTracer, this));
-    Config::Connect ("/NodeList/"+(node)+"/$ns3::QuicL4Protocol/SocketList/0/QuicSocketBase/State", MakeCallback (&NodeStatistics::QuicHandshakeTracer, this));
+    Config::ConnectWithoutContext ("/NodeList/"+(node)+"/$ns3::QuicL4Protocol/SocketList/0/QuicSocketBase/CongestionWindow", MakeBoundCallback (&NodeStatistics::CwndTracer, nodeCwnd[node]));
+    Config::ConnectWithoutContext ("/NodeList/"+(node)+"/$ns3::QuicL4Protocol/SocketList/0/QuicSocketBase/SlowStartThreshold", MakeBoundCallback (&NodeStatistics::SsThTracer, nodeSsth[node]));
+    Config::ConnectWithoutContext ("/NodeList/"+(node)+"/$ns3::QuicL4Protocol/SocketList/0/QuicSocketBase/State", MakeBoundCallback (&NodeStatistics::QuicHandshakeTracer, nodeHandshake[node]));
 }
 
 void NodeStatistics::AdvancePosition(int stepsTime){
@@ -132,16 +148,17 @@ void NodeStatistics::AdvancePosition(int stepsTime){
 }
 
 void NodeStatistics::Metrics(){
-    Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier> (fh.GetClassifier());
-    std::map<FlowId, FlowMonitor::FlowStats> stats = monitor->GetFlowStats();
-    for (std::map<FlowId, FlowMonitor::FlowStats>::const_iterator iter = stats.begin(); iter != stats.end(); ++iter){
-        Ipv4FlowClassifier::FiveTuple tuple = classifier->FindFlow(iter->first);
-        int64_t new_kbps = iter->second.rxBytes * 8.0/(iter->second.timeLastRxPacket.GetSeconds() + 0.01 - iter->second.timeFirstTxPacket.GetSeconds())/1024;
-        int64_t new_jtr = iter->second.jitterSum.GetMilliSeconds();
-        int64_t new_plr = std::abs((int)iter->second.txPackets - (int)iter->second.rxPackets)*100/(iter->second.txPackets + 0.01);
-        int64_t new_del = iter->second.lastDelay.GetMilliSeconds();
-        int64_t new_sen = iter->second.txPackets;
-        int64_t new_rcv = iter->second.rxPackets;
+    // Interval values from the difference to the previous step, so the
+    // cumulative stats are never reset
+    for (const FlowGroupMonitor::Flow& flow : flows->GetIntervals(flowGroup)){
+        const FlowInterval& interval = flow.metrics;
+        const Ipv4FlowClassifier::FiveTuple& tuple = flow.tuple;
+        int64_t new_kbps = interval.GetKbps();
+        int64_t new_jtr = interval.jitterSum.GetMilliSeconds();
+        int64_t new_plr = interval.GetLossPercent();
+        int64_t new_del = interval.lastDelay.GetMilliSeconds();
+        int64_t new_sen = interval.txPackets;
+        int64_t new_rcv = interval.rxPackets;
 
         NS_LOG_UNCOND(" " << stepItr << "|kbps:"
                           << new_kbps << "|jtr:"
@@ -160,43 +177,60 @@ void NodeStatistics::Metrics(){
                                  << new_del << ","
                                  << new_sen << ","
                                  << new_rcv << ","
-                                 << tuple.sourceAddress << std::endl;
-
+                                 << tuple.sourceAddress << ","
+                                 << interval.GetDelayPercentile(50).GetSeconds() * 1000 << ","
+                                 << interval.GetDelayPercentile(90).GetSeconds() * 1000 << ","
+                                 << interval.GetDelayPercentile(99).GetSeconds() * 1000 << ","
+                                 << interval.GetJitterPercentile(50).GetSeconds() * 1000 << ","
+                                 << interval.GetJitterPercentile(90).GetSeconds() * 1000 << ","
+                                 << interval.GetJitterPercentile(99).GetSeconds() * 1000 << std::endl;
+
+        // Only the flows towards the server carry the data
+        if (tuple.destinationAddress == server){
+            std::ostringstream flowKey; flowKey << flowName << "/" << tuple.sourceAddress;
+            if (steadyState != nullptr){
+                steadyState->Record(flowKey.str(), interval.GetKbps());
+            }
+            if (fairness != nullptr){
+                fairness->Record(protocol, flowKey.str(), interval.GetKbps());
+            }
+        }
     }
-
-    this->monitor->ResetAllStats();
 }
 
-std::string
-NodeStatistics::GetNodeIdFromContext(std::string context)
-{
-    const std::size_t n1 = context.find_first_of('/', 1);
-    const std::size_t n2 = context.find_first_of('/', n1 + 1);
-    return context.substr(n1 + 1, n2 - n1 - 1);
+void NodeStatistics::WriteTotals(){
+    std::ostringstream totals; totals << flowName << "-totals.csv";
+    Ptr<OutputStreamWrapper> totalsCsv = asciiHelper.CreateFileStream(totals.str().c_str());
+    *totalsCsv->GetStream() << "kbps,jtr_mean,plr,del_mean,sen,rcv,source" << std::endl;
+    for (const FlowGroupMonitor::Flow& flow : flows->GetTotals(flowGroup)){
+        *totalsCsv->GetStream() << flow.metrics.GetKbps() << ","
+                                << flow.metrics.GetMeanJitter().GetMilliSeconds() << ","
+                                << flow.metrics.GetLossPercent() << ","
+                                << flow.metrics.GetMeanDelay().GetMilliSeconds() << ","
+                                << flow.metrics.txPackets << ","
+                                << flow.metrics.rxPackets << ","
+                                << flow.tuple.sourceAddress << std::endl;
+    }
 }
 
 void
-NodeStatistics::CwndTracer(std::string context, uint32_t oldval, uint32_t newval){
-    std::string nodeId = GetNodeIdFromContext(context);
-    *nodeCwnd[nodeId]->GetStream() << Simulator::Now().GetSeconds() << "," << oldval << "," << newval << std::endl;
+NodeStatistics::CwndTracer(Ptr<BufferedTraceSink> stream, uint32_t oldval, uint32_t newval){
+    *stream->GetStream() << Simulator::Now().GetSeconds() << "," << oldval << "," << newval << '\n';
 }
 
 void
-NodeStatistics::SsThTracer(std::string context, uint32_t oldval, uint32_t newval){
-    std::string nodeId = GetNodeIdFromContext(context);
-    *nodeSsth[nodeId]->GetStream() << Simulator::Now().GetSeconds() << "," << oldval << "," << newval << std::endl;
+NodeStatistics::SsThTracer(Ptr<BufferedTraceSink> stream, uint32_t oldval, uint32_t newval){
+    *stream->GetStream() << Simulator::Now().GetSeconds() << "," << oldval << "," << newval << '\n';
 }
 
 void
-NodeStatistics::TcpHandshakeTracer(std::string context,  const TcpSocket::TcpStates_t oldState, const TcpSocket::TcpStates_t newState){
-    std::string nodeId = GetNodeIdFromContext(context);
-    *nodeHandshake[nodeId]->GetStream() << Simulator::Now().GetSeconds() << "," << TcpStateToString(oldState) << "," << TcpStateToString(newState) << std::endl;
+NodeStatistics::TcpHandshakeTracer(Ptr<BufferedTraceSink> stream, const TcpSocket::TcpStates_t oldState, const TcpSocket::TcpStates_t newState){
+    *stream->GetStream() << Simulator::Now().GetSeconds() << "," << TcpStateToString(oldState) << "," << TcpStateToString(newState) << '\n';
 }
 
 void
-NodeStatistics::QuicHandshakeTracer(std::string context,  const QuicSocket::QuicStates_t oldState, const QuicSocket::QuicStates_t newState){
-    std::string nodeId = GetNodeIdFromContext(context);
-    *nodeHandshake[nodeId]->GetStream() << Simulator::Now().GetSeconds() << "," << QuicStateToString(oldState) << "," << QuicStateToString(newState) << std::endl;
+NodeStatistics::QuicHandshakeTracer(Ptr<BufferedTraceSink> stream, const QuicSocket::QuicStates_t oldState, const QuicSocket::QuicStates_t newState){
+    *stream->GetStream() << Simulator::Now().GetSeconds() << "," << QuicStateToString(oldState) << "," << QuicStateToString(newState) << '\n';
 }
 
 std::string
@@ -254,7 +288,36 @@ NodeStatistics::QuicStateToString(QuicSocket::QuicStates_t state){
     }
 }
 
-int main(){
+int main(int argc, char* argv[]){
+    // Opt-in per-event-type wall time profile, e.g. --profile=event-profile.tsv
+    std::string profile = "";
+    CommandLine cmd;
+    // Opt-in early stop once throughput and fairness are stable over steadyWindow steps
+    int steadyWindow = 0;
+    double steadyTolerance = 0.05;
+    // Opt-in delivery to the WiFi receivers in range only, same results
+    bool cullChannel = false;
+    // Opt-in caching of the propagation loss and delay between nodes until they move
+    bool cachePropagation = false;
+    // Opt-in table lookup of the WiFi chunk success rates
+    bool errorTable = false;
+    // Opt-in single co-channel WiFi channel for both APs, so the cells interfere
+    bool sharedChannel = false;
+    // With sharedChannel and cullChannel, distance beyond which a cell does not reach the other, 0 for no limit
+    double interferenceRange = 0;
+    cmd.AddValue("profile", "Write a per-event-type profile to this file on Simulator::Destroy", profile);
+    cmd.AddValue("steadyWindow", "Stop once this many steps are stable, 0 to always run to the end", steadyWindow);
+    cmd.AddValue("steadyTolerance", "Relative throughput and absolute Jain's index range of a stable window", steadyTolerance);
+    cmd.AddValue("cullChannel", "Skip the WiFi receivers out of range of each transmission", cullChannel);
+    cmd.AddValue("cachePropagation", "Cache the propagation loss and delay between nodes until they move", cachePropagation);
+    cmd.AddValue("errorTable", "Look the WiFi chunk success rates up in precomputed tables", errorTable);
+    cmd.AddValue("sharedChannel", "Put both APs and their stations on one WiFi channel", sharedChannel);
+    cmd.AddValue("interferenceRange", "With --sharedChannel --cullChannel, how far (m) frames of one BSS reach the other, 0 for the culling range", interferenceRange);
+    cmd.Parse(argc, argv);
+    if (profile != ""){
+        EnableEventProfiler(profile);
+    }
+
     LogComponentEnable("Gamma", LOG_LEVEL_INFO);
 
     std::string p2pGwDataRate = "1Gbps";
@@ -281,6 +344,10 @@ int main(){
     double error_p = 0.0;
 
     double duration = 10.0;
+    // Steps run every stepsTime seconds from firstStep; the UDP senders start last
+    int firstStep = 1;
+    int stepsTime = 1;
+    double udpStart = 1.5;
     double fileSize = 0;
     double packetSize = 1024;
 
@@ -478,10 +545,22 @@ int main(){
 
     WifiHelper wifi;
     wifi.SetStandard(WIFI_STANDARD_80211n);
-    YansWifiPhyHelper wifiPhy;
+    CulledYansWifiPhyHelper wifiPhy;
     YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default();
-    wifiPhy.SetChannel(wifiChannel.Create());
+    Ptr<YansWifiChannel> channel;
+    if (cullChannel){
+        channel = wifiPhy.SetCulledChannel(wifiChannel);
+    } else {
+        channel = wifiChannel.Create();
+        wifiPhy.SetChannel(channel);
+    }
+    if (cachePropagation){
+        CachePropagationModels(channel);
+    }
     wifiPhy.Set("ChannelSettings", StringValue("{0, 0, BAND_2_4GHZ, 0}"));
+    if (errorTable){
+        wifiPhy.SetErrorRateModel("ns3::TabulatedErrorRateModel");
+    }
     wifiChannel.SetPropagationDelay(propagationDelay);
     wifiChannel.AddPropagationLoss(propagationLoss);
     WifiMacHelper wifiMac;
@@ -499,10 +578,25 @@ int main(){
 
     WifiHelper wifi2;
     wifi.SetStandard(WIFI_STANDARD_80211n);
-    YansWifiPhyHelper wifiPhy2;
+    CulledYansWifiPhyHelper wifiPhy2;
     YansWifiChannelHelper wifiChannel2 = YansWifiChannelHelper::Default();
-    wifiPhy2.SetChannel(wifiChannel2.Create());
+    Ptr<YansWifiChannel> channel2;
+    if (sharedChannel){
+        channel2 = channel;
+        wifiPhy2 = wifiPhy;
+    } else if (cullChannel){
+        channel2 = wifiPhy2.SetCulledChannel(wifiChannel2);
+    } else {
+        channel2 = wifiChannel2.Create();
+        wifiPhy2.SetChannel(channel2);
+    }
+    if (cachePropagation && !sharedChannel){
+        CachePropagationModels(channel2);
+    }
     wifiPhy2.Set("ChannelSettings", StringValue("{0, 0, BAND_2_4GHZ, 0}"));
+    if (errorTable){
+        wifiPhy2.SetErrorRateModel("ns3::TabulatedErrorRateModel");
+    }
     wifiChannel2.SetPropagationDelay(propagationDelay);
     wifiChannel2.AddPropagationLoss(propagationLoss);
     WifiMacHelper wifiMac2;
@@ -516,6 +610,19 @@ int main(){
     wifiBUdpStaDevices.Add(wifi.Install(wifiPhy2, wifiMac2, UdpBNodes));
     wifiMac2.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid2));//AP
     NetDeviceContainer wifiBApDevices = wifi.Install(wifiPhy2, wifiMac2, apBNodes);
+    Ptr<CulledYansWifiChannel> culledChannel = DynamicCast<CulledYansWifiChannel>(channel);
+    if (sharedChannel && culledChannel){
+        // Each BSS gets its own delivery list, the other one only interferes
+        NetDeviceContainer cellA(wifiATcpStaDevices, wifiAQuicStaDevices);
+        cellA.Add(wifiAUdpStaDevices);
+        cellA.Add(wifiApDevices);
+        NetDeviceContainer cellB(wifiBTcpStaDevices, wifiBQuicStaDevices);
+        cellB.Add(wifiBUdpStaDevices);
+        cellB.Add(wifiBApDevices);
+        culledChannel->AddCell(cellA);
+        culledChannel->AddCell(cellB);
+        culledChannel->SetAttribute("InterferenceRange", DoubleValue(interferenceRange));
+    }
 
 
     PointToPointHelper APAP2p;//point to point line between AP A and GW A
@@ -662,7 +769,7 @@ int main(){
         udpOnoffA.SetAttribute("OffTime", StringValue("ns3::ConstantRandomVariable[Constant=0]"));
     }
     ApplicationContainer udpSenderA; udpSenderA.Add(udpOnoffA.Install(UdpANodes.Get(0)));
-    udpSenderA.Get(0)->SetStartTime(Seconds(1.5)); udpSenderA.Get(0)->SetStopTime(Seconds(duration - 1.0));
+    udpSenderA.Get(0)->SetStartTime(Seconds(udpStart)); udpSenderA.Get(0)->SetStopTime(Seconds(duration - 1.0));
 
     OnOffHelper udpOnoffB("ns3::UdpSocketFactory", InetSocketAddress(UdpinternetIpIfaces.GetAddress(1), 3000));
     if (BUdpFlowNum < 1){
@@ -675,7 +782,7 @@ int main(){
         udpOnoffB.SetAttribute("OffTime", StringValue("ns3::ConstantRandomVariable[Constant=0]"));
     }
     ApplicationContainer udpSenderB; udpSenderB.Add(udpOnoffB.Install(UdpBNodes.Get(0)));
-    udpSenderB.Get(0)->SetStartTime(Seconds(1.5)); udpSenderB.Get(0)->SetStopTime(Seconds(duration - 1.0));
+    udpSenderB.Get(0)->SetStartTime(Seconds(udpStart)); udpSenderB.Get(0)->SetStopTime(Seconds(duration - 1.0));
 
     PacketSinkHelper udpReceiverSink("ns3::UdpSocketFactory", InetSocketAddress(UdpinternetIpIfaces.GetAddress(1), 3000));
     ApplicationContainer udpSinkApp = udpReceiverSink.Install(UdpSrvNodes.Get(0));
@@ -683,12 +790,10 @@ int main(){
 
 
 
-    std::time_t unixNow = std::time(0);
-    struct tm *localTime = localtime(&unixNow);
-    std::stringstream formattedTime; formattedTime << std::put_time(localTime, "%Y-%m-%d_%H:%M:%S");
-    std::string folderName = formattedTime.str();
-    std::filesystem::path directoryPath = "./"+ folderName +"/";
-    std::filesystem::create_directory(directoryPath);
+    // A fresh timestamp-pid folder, so that parallel runs do not share one
+    std::string folderName = AllocateRunDirectory(".");
+    RunManifest manifest("./" + folderName, folderName);
+    manifest.SetCommandLine(argc, argv);
     TcpremoteServerp2p.EnablePcap( "./" + folderName + "/" + "apToGw", gwBNodes);
 //    AnimationInterface anim("./" + folderName + "/gamma.xml");
 
@@ -697,26 +802,59 @@ int main(){
 
 
 
-    NodeStatistics* nodeStatTcp = new NodeStatistics(NodeContainer(TcpUeNodes,  TcpSrvNodes.Get(0)),"./"+ folderName +"/TCP", 0);
-    Simulator::Schedule(Seconds(1),
+    // One monitor over every UE and server; the flows are split by server
+    NodeContainer monitoredNodes;
+    monitoredNodes.Add(TcpUeNodes);
+    monitoredNodes.Add(QuicUeNodes);
+    monitoredNodes.Add(UdpUeNodes);
+    monitoredNodes.Add(TcpSrvNodes);
+    monitoredNodes.Add(QuicSrvNodes);
+    monitoredNodes.Add(UdpSrvNodes);
+    FlowGroupMonitor flowMonitor(monitoredNodes);
+
+    // From the first step over time after the UDP start, less half a step
+    SteadyStateMonitor* steadyState = nullptr;
+    if (steadyWindow > 0){
+        double steadyStart = firstStep + std::ceil((udpStart - firstStep) / stepsTime) * stepsTime + stepsTime / 2.0;
+        steadyState = new SteadyStateMonitor(steadyWindow, steadyTolerance, Seconds(steadyStart));
+    }
+
+    NodeStatistics* nodeStatTcp = new NodeStatistics(&flowMonitor, TcpinternetIpIfaces.GetAddress(1),"./"+ folderName +"/TCP", 0);
+    Simulator::Schedule(Seconds(firstStep),
                         &NodeStatistics::AdvancePosition,
                         nodeStatTcp,
-                        1);
+                        stepsTime);
 
-    NodeStatistics* nodeStatQuic = new NodeStatistics(NodeContainer(QuicUeNodes,  QuicSrvNodes.Get(0)),"./"+ folderName +"/QUIC", 1);
-    Simulator::Schedule(Seconds(1),
+    NodeStatistics* nodeStatQuic = new NodeStatistics(&flowMonitor, QuicinternetIpIfaces.GetAddress(1),"./"+ folderName +"/QUIC", 1);
+    Simulator::Schedule(Seconds(firstStep),
                         &NodeStatistics::AdvancePosition,
                         nodeStatQuic,
-                        1);
+                        stepsTime);
 
-    NodeStatistics* nodeStatUdp = new NodeStatistics(NodeContainer(UdpUeNodes,  UdpSrvNodes.Get(0)),"./"+ folderName +"/UDP", 2);
-    Simulator::Schedule(Seconds(1),
+    NodeStatistics* nodeStatUdp = new NodeStatistics(&flowMonitor, UdpinternetIpIfaces.GetAddress(1),"./"+ folderName +"/UDP", 2);
+    Simulator::Schedule(Seconds(firstStep),
                         &NodeStatistics::AdvancePosition,
                         nodeStatUdp,
-                        1);
+                        stepsTime);
+    nodeStatTcp->steadyState = steadyState;
+    nodeStatQuic->steadyState = steadyState;
+    nodeStatUdp->steadyState = steadyState;
+
+    // Jain's index, max-min ratio and protocol shares of every step
+    FairnessMonitor fairness("./" + folderName + "/fairness.csv", {"TCP", "QUIC", "UDP"});
+    nodeStatTcp->fairness = &fairness;
+    nodeStatQuic->fairness = &fairness;
+    nodeStatUdp->fairness = &fairness;
 
 
     Simulator::Run();
+    nodeStatTcp->WriteTotals();
+    nodeStatQuic->WriteTotals();
+    nodeStatUdp->WriteTotals();
+    if (steadyState != nullptr){
+        steadyState->WriteSummary("./" + folderName + "/steady-state.ini");
+    }
+    manifest.Finish(0);
     Simulator::Destroy();
 
     return 0;
@@ -24,34 +24,39 @@
 #include "ns3/applications-module.h"
 #include "ns3/flow-monitor-module.h"
 
+#include "../fairness/lib/binary-trace.h"
+#include "../fairness/lib/buffered-trace-sink.h"
+
 #include <arpa/inet.h>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE ("Simulation_1");
 
 
-static Ptr<OutputStreamWrapper> TcpcWndStream;
-static Ptr<OutputStreamWrapper> TcprttStream;
+static Ptr<BufferedTraceSink> TcpcWndStream;
+static Ptr<BufferedTraceSink> TcprttStream;
 
 static void
 CwndTracer (uint32_t oldval, uint32_t newval)
 {
-    *TcpcWndStream->GetStream () << Simulator::Now ().GetSeconds () << "," << oldval << "," << newval << std::endl;
+    *TcpcWndStream->GetStream () << Simulator::Now ().GetSeconds () << "," << oldval << "," << newval << '\n';
 }
 
 
 static void
 RttTracer (Time oldval, Time newval)
 {
-    *TcprttStream->GetStream () << Simulator::Now ().GetSeconds () << "," << oldval.GetSeconds () << "," << newval.GetSeconds () << std::endl;
+    *TcprttStream->GetStream () << Simulator::Now ().GetSeconds () << "," << oldval.GetSeconds () << "," << newval.GetSeconds () << '\n';
 }
 
 static void
 TraceCwnd (std::string cwnd_tr_file_name)
 {
-    AsciiTraceHelper ascii;
-    TcpcWndStream = ascii.CreateFileStream (cwnd_tr_file_name.c_str ());
+    TcpcWndStream = CreateBufferedTraceSink (cwnd_tr_file_name);
     Config::ConnectWithoutContext ("/NodeList/6/$ns3::TcpL4Protocol/SocketList/0/CongestionWindow", MakeCallback (&CwndTracer));
 
 }
@@ -59,8 +64,7 @@ TraceCwnd (std::string cwnd_tr_file_name)
 static void
 TraceRtt (std::string rtt_tr_file_name)
 {
-    AsciiTraceHelper ascii;
-    TcprttStream = ascii.CreateFileStream (rtt_tr_file_name.c_str ());
+    TcprttStream = CreateBufferedTraceSink (rtt_tr_file_name);
     Config::ConnectWithoutContext ("/NodeList/6/$ns3::TcpL4Protocol/SocketList/0/RTT", MakeCallback (&RttTracer));
 }
 
@@ -69,28 +73,44 @@ TraceRtt (std::string rtt_tr_file_name)
 // connect to a number of traces
 
 static void
-CwndChange (Ptr<OutputStreamWrapper> stream, uint32_t oldCwnd, uint32_t newCwnd)
+CwndChange (Ptr<BufferedTraceSink> stream, uint32_t oldCwnd, uint32_t newCwnd)
+{
+    *stream->GetStream () << Simulator::Now ().GetSeconds () << "," << oldCwnd << "," << newCwnd << '\n';
+}
+
+static void
+RttChange (Ptr<BufferedTraceSink> stream, Time oldRtt, Time newRtt)
 {
-    *stream->GetStream () << Simulator::Now ().GetSeconds () << "," << oldCwnd << "," << newCwnd << std::endl;
+    *stream->GetStream () << Simulator::Now ().GetSeconds () << "," << oldRtt.GetSeconds () << "," << newRtt.GetSeconds () << '\n';
 }
 
 static void
-RttChange (Ptr<OutputStreamWrapper> stream, Time oldRtt, Time newRtt)
+Rx (Ptr<BufferedTraceSink> stream, Ptr<const Packet> p, const QuicHeader& q, Ptr<const QuicSocketBase> qsb)
 {
-    *stream->GetStream () << Simulator::Now ().GetSeconds () << "," << oldRtt.GetSeconds () << "," << newRtt.GetSeconds () << std::endl;
+    *stream->GetStream () << Simulator::Now ().GetSeconds () << "," << p->GetSize() << '\n';
 }
 
 static void
-Rx (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p, const QuicHeader& q, Ptr<const QuicSocketBase> qsb)
+CwndChangeBinary (Ptr<BinaryTraceSink> sink, uint32_t oldCwnd, uint32_t newCwnd)
 {
-    *stream->GetStream () << Simulator::Now ().GetSeconds () << "," << p->GetSize() << std::endl;
+    sink->Write (Simulator::Now (), oldCwnd, newCwnd);
 }
 
 static void
-QuicTraces(uint32_t serverId, std::string pathVersion, std::string finalPart)
+RttChangeBinary (Ptr<BinaryTraceSink> sink, Time oldRtt, Time newRtt)
 {
-    AsciiTraceHelper asciiTraceHelper;
+    sink->Write (Simulator::Now (), oldRtt, newRtt);
+}
+
+static void
+RxBinary (Ptr<BinaryTraceSink> sink, Ptr<const Packet> p, const QuicHeader& q, Ptr<const QuicSocketBase> qsb)
+{
+    sink->Write (Simulator::Now (), p->GetSize ());
+}
 
+static void
+QuicTraces(uint32_t serverId, std::string pathVersion, std::string finalPart, bool binary)
+{
     std::ostringstream pathCW;
     pathCW << "/NodeList/" << serverId << "/$ns3::QuicL4Protocol/SocketList/0/QuicSocketBase/CongestionWindow";
     NS_LOG_INFO("Matches cw " << Config::LookupMatches(pathCW.str().c_str()).GetN());
@@ -118,52 +138,82 @@ QuicTraces(uint32_t serverId, std::string pathVersion, std::string finalPart)
 
     NS_LOG_INFO("Matches rx " << Config::LookupMatches(pathRx.str().c_str()).GetN());
 
-    Ptr<OutputStreamWrapper> stream = asciiTraceHelper.CreateFileStream (fileName.str ().c_str ());
+    if (binary)
+    {
+        const std::vector<BinaryTraceColumn> windowColumns = {{"time", BinaryTraceColumn::TIME},
+                                                              {"old", BinaryTraceColumn::UINT32},
+                                                              {"new", BinaryTraceColumn::UINT32}};
+        const std::vector<BinaryTraceColumn> rttColumns = {{"time", BinaryTraceColumn::TIME},
+                                                           {"old", BinaryTraceColumn::TIME},
+                                                           {"new", BinaryTraceColumn::TIME}};
+        const std::vector<BinaryTraceColumn> rxColumns = {{"time", BinaryTraceColumn::TIME},
+                                                          {"size", BinaryTraceColumn::UINT32}};
+        Config::ConnectWithoutContext (pathRx.str ().c_str (), MakeBoundCallback (&RxBinary, CreateBinaryTraceSink (fileName.str (), rxColumns)));
+        Config::ConnectWithoutContext (pathCW.str ().c_str (), MakeBoundCallback (&CwndChangeBinary, CreateBinaryTraceSink (fileCW.str (), windowColumns)));
+        Config::ConnectWithoutContext (pathRTT.str ().c_str (), MakeBoundCallback (&RttChangeBinary, CreateBinaryTraceSink (fileRTT.str (), rttColumns)));
+        Config::ConnectWithoutContext (pathRCWnd.str ().c_str (), MakeBoundCallback (&CwndChangeBinary, CreateBinaryTraceSink (fileRCWnd.str (), windowColumns)));
+        return;
+    }
+
+    Ptr<BufferedTraceSink> stream = CreateBufferedTraceSink (fileName.str ());
     Config::ConnectWithoutContext (pathRx.str ().c_str (), MakeBoundCallback (&Rx, stream));
 
-    Ptr<OutputStreamWrapper> stream1 = asciiTraceHelper.CreateFileStream (fileCW.str ().c_str ());
+    Ptr<BufferedTraceSink> stream1 = CreateBufferedTraceSink (fileCW.str ());
     Config::ConnectWithoutContext (pathCW.str ().c_str (), MakeBoundCallback(&CwndChange, stream1));
 
-    Ptr<OutputStreamWrapper> stream2 = asciiTraceHelper.CreateFileStream (fileRTT.str ().c_str ());
+    Ptr<BufferedTraceSink> stream2 = CreateBufferedTraceSink (fileRTT.str ());
     Config::ConnectWithoutContext (pathRTT.str ().c_str (), MakeBoundCallback(&RttChange, stream2));
 
-    Ptr<OutputStreamWrapper> stream4 = asciiTraceHelper.CreateFileStream (fileRCWnd.str ().c_str ());
+    Ptr<BufferedTraceSink> stream4 = CreateBufferedTraceSink (fileRCWnd.str ());
     Config::ConnectWithoutContext (pathRCWnd.str ().c_str (), MakeBoundCallback(&CwndChange, stream4));
 }
 
-bool isClient(Ipv4Address ipAddress, Ipv4InterfaceContainer containerAddress) {
-    for(uint32_t i = 0; i < containerAddress.GetN(); ++i) {
-        Ipv4Address clientAddress = containerAddress.Get(i).first->GetAddress(1, 0).GetLocal();
-        if(clientAddress == ipAddress) {
-            return true;
+// Client addresses of one throughput file and the flows already matched
+// against them, so each flow is classified once instead of every second
+struct ThroughputMonitorState {
+    FlowMonitorHelper *fmhelper;
+    Ptr<FlowMonitor> flowMon;
+    Ptr<OutputStreamWrapper> stream;
+    std::unordered_set<Ipv4Address, Ipv4AddressHash> clients;
+    std::unordered_map<FlowId, bool> clientFlows;
+
+    ThroughputMonitorState (FlowMonitorHelper *fmhelper, Ptr<FlowMonitor> flowMon, Ipv4InterfaceContainer ipIpIfaces, Ptr<OutputStreamWrapper> stream)
+        : fmhelper (fmhelper), flowMon (flowMon), stream (stream) {
+        for (uint32_t i = 0; i < ipIpIfaces.GetN (); ++i) {
+            clients.insert (ipIpIfaces.Get (i).first->GetAddress (1, 0).GetLocal ());
         }
     }
 
-    return false;
-}
+    bool isClientFlow (FlowId flowId) {
+        auto it = clientFlows.find (flowId);
+        if (it == clientFlows.end ()) {
+            Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier> (fmhelper->GetClassifier ());
+            Ipv4FlowClassifier::FiveTuple t = classifier->FindFlow (flowId);
+            it = clientFlows.emplace (flowId, clients.count (t.destinationAddress) > 0).first;
+        }
+        return it->second;
+    }
+};
 
 //Define function for Throughput Calculation every second
 
-void ThroughputMonitor (FlowMonitorHelper *fmhelper, Ptr<FlowMonitor> flowMon, Ipv4InterfaceContainer ipIpIfaces, Ptr<OutputStreamWrapper> temp) {
+void ThroughputMonitor (ThroughputMonitorState *state) {
 
 
-    *temp->GetStream () << Simulator::Now ().GetSeconds ();
+    *state->stream->GetStream () << Simulator::Now ().GetSeconds ();
 
-    Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier> (fmhelper->GetClassifier());
-    std::map<FlowId, FlowMonitor::FlowStats> stats = flowMon->GetFlowStats();
+    const FlowMonitor::FlowStatsContainer &stats = state->flowMon->GetFlowStats ();
 
-    for (std::map<FlowId, FlowMonitor::FlowStats>::const_iterator iter = stats.begin (); iter != stats.end (); ++iter) {
-        Ipv4FlowClassifier::FiveTuple t = classifier->FindFlow (iter->first);
+    for (FlowMonitor::FlowStatsContainerCI iter = stats.begin (); iter != stats.end (); ++iter) {
+        if (state->isClientFlow (iter->first)) {
 
-        if (isClient(t.destinationAddress, ipIpIfaces)) {
-
-            *temp->GetStream () << "," << ((iter->second.rxBytes * 8.0) / (iter->second.timeLastRxPacket.GetSeconds() - iter->second.timeFirstTxPacket.GetSeconds()) / 1000000);
+            *state->stream->GetStream () << "," << ((iter->second.rxBytes * 8.0) / (iter->second.timeLastRxPacket.GetSeconds() - iter->second.timeFirstTxPacket.GetSeconds()) / 1000000);
         }
     }
 
-    *temp->GetStream() << std::endl;
+    *state->stream->GetStream() << std::endl;
 
-    Simulator::Schedule(Seconds(1.0), &ThroughputMonitor, fmhelper, flowMon, ipIpIfaces, temp);
+    Simulator::Schedule(Seconds(1.0), &ThroughputMonitor, state);
 }
 
 
@@ -190,6 +240,7 @@ int main(int argc, char *argv[]) {
     bool use_2RTT = true;
     bool KPI_tracing = false;
     bool Throughput_Trace = true;
+    bool binary_traces = false;
     std::string tcp_congestion_op = "TcpNewReno";
 
     Vector eNBposition = Vector(distance, 0, 15);
@@ -213,6 +264,7 @@ int main(int argc, char *argv[]) {
     cmd.AddValue ("use_2RTT", "Enable 2-RTT Handshake", use_2RTT);
     cmd.AddValue ("KPI_tracing", "Enable the CWND and RTT tracing", KPI_tracing);
     cmd.AddValue ("Throughput_Trace", "Enable the throughput tracing", Throughput_Trace);
+    cmd.AddValue ("binary_traces", "Write the QUIC KPI traces in the binary format", binary_traces);
 
     cmd.Parse(argc, argv);
 
@@ -565,7 +617,7 @@ int main(int argc, char *argv[]) {
             Ptr<Node> quicClient = quicNodes.Get (i);
             Ptr<Node> server = remoteServerContainer.Get (1); //quicServer
             Time t = Seconds(1.05 + (i*0.1) + 0.00001);
-            Simulator::Schedule (t, &QuicTraces, server->GetId(), "sender", ".csv");
+            Simulator::Schedule (t, &QuicTraces, server->GetId(), "sender", binary_traces ? ".btr" : ".csv", binary_traces);
         }
     }
 
@@ -578,6 +630,7 @@ int main(int argc, char *argv[]) {
     flowMonitor = flowHelper.InstallAll();
     flowMonitor->Start(Seconds(0.0));
 
+    std::unique_ptr<ThroughputMonitorState> tcpThroughputState, quicThroughputState;
     if (Throughput_Trace)
     {
         //Create files for Throughput Calculations
@@ -592,9 +645,12 @@ int main(int argc, char *argv[]) {
         Ptr<OutputStreamWrapper> streamThroughput_1 = asciiHelper.CreateFileStream (tcpThroughput.str ().c_str ());
         Ptr<OutputStreamWrapper> streamThroughput_2 = asciiHelper.CreateFileStream (quicThroughput.str ().c_str ());
 
+        tcpThroughputState.reset (new ThroughputMonitorState (&flowHelper, flowMonitor, tcpIpIfaces, streamThroughput_1));
+        quicThroughputState.reset (new ThroughputMonitorState (&flowHelper, flowMonitor, quicIpIfaces, streamThroughput_2));
+
         //Schedule Flow Monitor every second
-        Simulator::Schedule(Seconds(0.50), &ThroughputMonitor, &flowHelper, flowMonitor, tcpIpIfaces, streamThroughput_1);
-        Simulator::Schedule(Seconds(0.51), &ThroughputMonitor, &flowHelper, flowMonitor, quicIpIfaces, streamThroughput_2);
+        Simulator::Schedule(Seconds(0.50), &ThroughputMonitor, tcpThroughputState.get ());
+        Simulator::Schedule(Seconds(0.51), &ThroughputMonitor, quicThroughputState.get ());
 
     }
 
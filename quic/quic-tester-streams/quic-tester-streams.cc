@@ -29,6 +29,9 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/applications-module.h"
 #include "ns3/config-store-module.h"
+
+#include "../../fairness/lib/buffered-trace-sink.h"
+
 #include <iostream>
 
 using namespace ns3;
@@ -37,28 +40,26 @@ NS_LOG_COMPONENT_DEFINE("QuicTesterStreams");
 
 // connect to a number of traces
 static void
-CwndChange (Ptr<OutputStreamWrapper> stream, uint32_t oldCwnd, uint32_t newCwnd)
+CwndChange (Ptr<BufferedTraceSink> stream, uint32_t oldCwnd, uint32_t newCwnd)
 {
-  *stream->GetStream () << Simulator::Now ().GetSeconds () << "\t" << oldCwnd << "\t" << newCwnd << std::endl;
+  *stream->GetStream () << Simulator::Now ().GetSeconds () << "\t" << oldCwnd << "\t" << newCwnd << '\n';
 }
 
 static void
-RttChange (Ptr<OutputStreamWrapper> stream, Time oldRtt, Time newRtt)
+RttChange (Ptr<BufferedTraceSink> stream, Time oldRtt, Time newRtt)
 {
-  *stream->GetStream () << Simulator::Now ().GetSeconds () << "\t" << oldRtt.GetSeconds () << "\t" << newRtt.GetSeconds () << std::endl;
+  *stream->GetStream () << Simulator::Now ().GetSeconds () << "\t" << oldRtt.GetSeconds () << "\t" << newRtt.GetSeconds () << '\n';
 }
 
 static void
-Rx (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p, const QuicHeader& q, Ptr<const QuicSocketBase> qsb)
+Rx (Ptr<BufferedTraceSink> stream, Ptr<const Packet> p, const QuicHeader& q, Ptr<const QuicSocketBase> qsb)
 {
-  *stream->GetStream () << Simulator::Now ().GetSeconds () << "\t" << p->GetSize() << std::endl;
+  *stream->GetStream () << Simulator::Now ().GetSeconds () << "\t" << p->GetSize() << '\n';
 }
 
 static void
 Traces(uint32_t serverId, std::string pathVersion, std::string finalPart)
 {
-  AsciiTraceHelper asciiTraceHelper;
-
   std::ostringstream pathCW;
   pathCW << "/NodeList/" << serverId << "/$ns3::QuicL4Protocol/SocketList/0/QuicSocketBase/CongestionWindow";
   NS_LOG_INFO("Matches cw " << Config::LookupMatches(pathCW.str().c_str()).GetN());
@@ -84,16 +85,16 @@ Traces(uint32_t serverId, std::string pathVersion, std::string finalPart)
   pathRx << "/NodeList/" << serverId << "/$ns3::QuicL4Protocol/SocketList/*/QuicSocketBase/Rx";
   NS_LOG_INFO("Matches rx " << Config::LookupMatches(pathRx.str().c_str()).GetN());
 
-  Ptr<OutputStreamWrapper> stream = asciiTraceHelper.CreateFileStream (fileName.str ().c_str ());
+  Ptr<BufferedTraceSink> stream = CreateBufferedTraceSink (fileName.str ());
   Config::ConnectWithoutContext (pathRx.str ().c_str (), MakeBoundCallback (&Rx, stream));
 
-  Ptr<OutputStreamWrapper> stream1 = asciiTraceHelper.CreateFileStream (fileCW.str ().c_str ());
+  Ptr<BufferedTraceSink> stream1 = CreateBufferedTraceSink (fileCW.str ());
   Config::ConnectWithoutContext (pathCW.str ().c_str (), MakeBoundCallback(&CwndChange, stream1));
 
-  Ptr<OutputStreamWrapper> stream2 = asciiTraceHelper.CreateFileStream (fileRTT.str ().c_str ());
+  Ptr<BufferedTraceSink> stream2 = CreateBufferedTraceSink (fileRTT.str ());
   Config::ConnectWithoutContext (pathRTT.str ().c_str (), MakeBoundCallback(&RttChange, stream2));
 
-  Ptr<OutputStreamWrapper> stream4 = asciiTraceHelper.CreateFileStream (fileRCWnd.str ().c_str ());
+  Ptr<BufferedTraceSink> stream4 = CreateBufferedTraceSink (fileRCWnd.str ());
   Config::ConnectWithoutContextFailSafe (pathRCWnd.str ().c_str (), MakeBoundCallback(&CwndChange, stream4));
 }
 
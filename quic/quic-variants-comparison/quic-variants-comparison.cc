@@ -57,34 +57,53 @@
 #include "ns3/ipv4-global-routing-helper.h"
 #include "ns3/traffic-control-module.h"
 
+#include "../../fairness/lib/binary-trace.h"
+#include "../../fairness/lib/buffered-trace-sink.h"
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE ("QuicVariantsComparison");
 
 // connect to a number of traces
 static void
-CwndChange (Ptr<OutputStreamWrapper> stream, uint32_t oldCwnd, uint32_t newCwnd)
+CwndChange (Ptr<BufferedTraceSink> stream, uint32_t oldCwnd, uint32_t newCwnd)
+{
+  *stream->GetStream () << Simulator::Now ().GetSeconds () << "\t" << oldCwnd << "\t" << newCwnd << '\n';
+}
+
+static void
+RttChange (Ptr<BufferedTraceSink> stream, Time oldRtt, Time newRtt)
 {
-  *stream->GetStream () << Simulator::Now ().GetSeconds () << "\t" << oldCwnd << "\t" << newCwnd << std::endl;
+  *stream->GetStream () << Simulator::Now ().GetSeconds () << "\t" << oldRtt.GetSeconds () << "\t" << newRtt.GetSeconds () << '\n';
 }
 
 static void
-RttChange (Ptr<OutputStreamWrapper> stream, Time oldRtt, Time newRtt)
+Rx (Ptr<BufferedTraceSink> stream, Ptr<const Packet> p, const QuicHeader& q, Ptr<const QuicSocketBase> qsb)
 {
-  *stream->GetStream () << Simulator::Now ().GetSeconds () << "\t" << oldRtt.GetSeconds () << "\t" << newRtt.GetSeconds () << std::endl;
+  *stream->GetStream () << Simulator::Now ().GetSeconds () << "\t" << p->GetSize() << '\n';
 }
 
 static void
-Rx (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p, const QuicHeader& q, Ptr<const QuicSocketBase> qsb)
+CwndChangeBinary (Ptr<BinaryTraceSink> sink, uint32_t oldCwnd, uint32_t newCwnd)
 {
-  *stream->GetStream () << Simulator::Now ().GetSeconds () << "\t" << p->GetSize() << std::endl;
+  sink->Write (Simulator::Now (), oldCwnd, newCwnd);
 }
 
 static void
-Traces(uint32_t serverId, std::string pathVersion, std::string finalPart)
+RttChangeBinary (Ptr<BinaryTraceSink> sink, Time oldRtt, Time newRtt)
 {
-  AsciiTraceHelper asciiTraceHelper;
+  sink->Write (Simulator::Now (), oldRtt, newRtt);
+}
 
+static void
+RxBinary (Ptr<BinaryTraceSink> sink, Ptr<const Packet> p, const QuicHeader& q, Ptr<const QuicSocketBase> qsb)
+{
+  sink->Write (Simulator::Now (), p->GetSize ());
+}
+
+static void
+Traces(uint32_t serverId, std::string pathVersion, std::string finalPart, bool binary)
+{
   std::ostringstream pathCW;
   pathCW << "/NodeList/" << serverId << "/$ns3::QuicL4Protocol/SocketList/0/QuicSocketBase/CongestionWindow";
   NS_LOG_INFO("Matches cw " << Config::LookupMatches(pathCW.str().c_str()).GetN());
@@ -110,16 +129,33 @@ Traces(uint32_t serverId, std::string pathVersion, std::string finalPart)
   pathRx << "/NodeList/" << serverId << "/$ns3::QuicL4Protocol/SocketList/*/QuicSocketBase/Rx";
   NS_LOG_INFO("Matches rx " << Config::LookupMatches(pathRx.str().c_str()).GetN());
 
-  Ptr<OutputStreamWrapper> stream = asciiTraceHelper.CreateFileStream (fileName.str ().c_str ());
+  if (binary)
+    {
+      const std::vector<BinaryTraceColumn> windowColumns = {{"time", BinaryTraceColumn::TIME},
+                                                            {"old", BinaryTraceColumn::UINT32},
+                                                            {"new", BinaryTraceColumn::UINT32}};
+      const std::vector<BinaryTraceColumn> rttColumns = {{"time", BinaryTraceColumn::TIME},
+                                                         {"old", BinaryTraceColumn::TIME},
+                                                         {"new", BinaryTraceColumn::TIME}};
+      const std::vector<BinaryTraceColumn> rxColumns = {{"time", BinaryTraceColumn::TIME},
+                                                        {"size", BinaryTraceColumn::UINT32}};
+      Config::ConnectWithoutContext (pathRx.str ().c_str (), MakeBoundCallback (&RxBinary, CreateBinaryTraceSink (fileName.str (), rxColumns)));
+      Config::ConnectWithoutContext (pathCW.str ().c_str (), MakeBoundCallback (&CwndChangeBinary, CreateBinaryTraceSink (fileCW.str (), windowColumns)));
+      Config::ConnectWithoutContext (pathRTT.str ().c_str (), MakeBoundCallback (&RttChangeBinary, CreateBinaryTraceSink (fileRTT.str (), rttColumns)));
+      Config::ConnectWithoutContextFailSafe (pathRCWnd.str ().c_str (), MakeBoundCallback (&CwndChangeBinary, CreateBinaryTraceSink (fileRCWnd.str (), windowColumns)));
+      return;
+    }
+
+  Ptr<BufferedTraceSink> stream = CreateBufferedTraceSink (fileName.str ());
   Config::ConnectWithoutContext (pathRx.str ().c_str (), MakeBoundCallback (&Rx, stream));
 
-  Ptr<OutputStreamWrapper> stream1 = asciiTraceHelper.CreateFileStream (fileCW.str ().c_str ());
+  Ptr<BufferedTraceSink> stream1 = CreateBufferedTraceSink (fileCW.str ());
   Config::ConnectWithoutContext (pathCW.str ().c_str (), MakeBoundCallback(&CwndChange, stream1));
 
-  Ptr<OutputStreamWrapper> stream2 = asciiTraceHelper.CreateFileStream (fileRTT.str ().c_str ());
+  Ptr<BufferedTraceSink> stream2 = CreateBufferedTraceSink (fileRTT.str ());
   Config::ConnectWithoutContext (pathRTT.str ().c_str (), MakeBoundCallback(&RttChange, stream2));
 
-  Ptr<OutputStreamWrapper> stream4 = asciiTraceHelper.CreateFileStream (fileRCWnd.str ().c_str ());
+  Ptr<BufferedTraceSink> stream4 = CreateBufferedTraceSink (fileRCWnd.str ());
   Config::ConnectWithoutContextFailSafe (pathRCWnd.str ().c_str (), MakeBoundCallback(&CwndChange, stream4));
 }
 
@@ -132,6 +168,7 @@ int main (int argc, char *argv[])
   std::string access_bandwidth = "12Mbps";
   std::string access_delay = "25ms";
   bool tracing = false;
+  bool binary_traces = false;
   std::string prefix_file_name = "QuicVariantsComparison";
   double data_mbytes = 0;
   uint32_t mtu_bytes = 1400;
@@ -153,6 +190,7 @@ int main (int argc, char *argv[])
   cmd.AddValue ("access_bandwidth", "Access link bandwidth", access_bandwidth);
   cmd.AddValue ("access_delay", "Access link delay", access_delay);
   cmd.AddValue ("tracing", "Flag to enable/disable tracing", tracing);
+  cmd.AddValue ("binary_traces", "Write the QUIC traces in the binary format", binary_traces);
   cmd.AddValue ("prefix_name", "Prefix of output trace file", prefix_file_name);
   cmd.AddValue ("data", "Number of Megabytes of data to transmit", data_mbytes);
   cmd.AddValue ("mtu", "Size of IP packets to send in bytes", mtu_bytes);
@@ -330,9 +368,9 @@ int main (int argc, char *argv[])
       auto n1 = sources.Get (i);
       Time t = Seconds(2.100001);
       Simulator::Schedule (t, &Traces, n2->GetId(),
-            "./server", ".txt");
+            "./server", binary_traces ? ".btr" : ".txt", binary_traces);
       Simulator::Schedule (t, &Traces, n1->GetId(),
-            "./client", ".txt");
+            "./client", binary_traces ? ".btr" : ".txt", binary_traces);
     }
 
   if (pcap)